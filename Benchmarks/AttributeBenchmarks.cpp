@@ -0,0 +1,55 @@
+#include "Core/Attribute.hpp"
+#include "Core/DataTypes.hpp"
+#include "Core/TypeRegistry.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace cf::core;
+
+namespace {
+
+AttributeDescriptor registerFloatAttribute()
+{
+    static AttributeDescriptor desc = [] {
+        TypeRegistry::registerType<Float>();
+
+        AttributeDescriptor descriptor;
+        descriptor.name = "Benchmark Attribute";
+        descriptor.typeHandle = TypeRegistry::getTypeHandle<Float>();
+        TypeRegistry::registerAttributeDescriptor(descriptor);
+        return descriptor;
+    }();
+    return desc;
+}
+
+} // namespace
+
+// A read is a type check and a load; nothing is looked up or allocated
+static void BM_AttributeGetValue(benchmark::State& state)
+{
+    Attribute attribute(registerFloatAttribute(), 1);
+    attribute.setValue(1.0f);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(attribute.getValue<float>());
+    }
+}
+BENCHMARK(BM_AttributeGetValue);
+
+// Changes are captured rather than published, so only the write itself is measured
+static void BM_AttributeSetValue(benchmark::State& state)
+{
+    Attribute attribute(registerFloatAttribute(), 1);
+
+    std::vector<AttributeHandle> changes;
+    changes.reserve(1);
+    AttributeChangeCapture capture(changes);
+
+    float value = 0.0f;
+    for (auto _ : state) {
+        attribute.setValue(value);
+        value += 1.0f;
+        changes.clear();
+    }
+}
+BENCHMARK(BM_AttributeSetValue);
@@ -0,0 +1,160 @@
+#include "Core/DataTypes.hpp"
+#include "Core/Nodes/AddNode.hpp"
+#include "Core/SampleBatch.hpp"
+#include "Core/Scene.hpp"
+#include "Core/TypeRegistry.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+using namespace cf::core;
+
+namespace {
+
+void registerBenchmarkTypes()
+{
+    static bool registered = [] {
+        spdlog::set_level(spdlog::level::warn);
+
+        TypeRegistry::registerType<Float>();
+        TypeRegistry::registerNodeType<AddNode>();
+        return true;
+    }();
+    (void)registered;
+}
+
+// Every node feeds its successor and one node halfway down the chain, so the
+// graph has roughly two connections per node
+std::vector<std::shared_ptr<AddNode>> buildLayeredGraph(Scene& scene, size_t nodeCount)
+{
+    std::vector<std::shared_ptr<AddNode>> nodes;
+    nodes.reserve(nodeCount);
+
+    for (size_t i = 0; i < nodeCount; ++i) {
+        nodes.push_back(scene.addNode(std::make_unique<AddNode>()));
+    }
+
+    for (size_t i = 1; i < nodeCount; ++i) {
+        scene.addConnection(nodes[i - 1]->outputs.result.getHandle(), nodes[i]->inputs.input1.getHandle());
+        scene.addConnection(nodes[i / 2]->outputs.result.getHandle(), nodes[i]->inputs.input2.getHandle());
+    }
+
+    return nodes;
+}
+
+} // namespace
+
+static void BM_SceneAddNodeOneByOne(benchmark::State& state)
+{
+    registerBenchmarkTypes();
+
+    for (auto _ : state) {
+        Scene scene;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            benchmark::DoNotOptimize(scene.addNode(std::make_unique<AddNode>()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneAddNodeOneByOne)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneAddNodes(benchmark::State& state)
+{
+    registerBenchmarkTypes();
+
+    for (auto _ : state) {
+        Scene scene;
+        benchmark::DoNotOptimize(scene.addNodes<AddNode>(static_cast<size_t>(state.range(0))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneAddNodes)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneEvaluateSingleEdit(benchmark::State& state)
+{
+    registerBenchmarkTypes();
+
+    Scene scene;
+    auto nodes = buildLayeredGraph(scene, static_cast<size_t>(state.range(0)));
+    scene.evaluate();
+
+    // Editing the last node keeps the dirty region to a single node, so the
+    // measurement is dominated by per-evaluation overhead such as sorting
+    auto input = scene.getAttribute(nodes.back()->inputs.input2.getHandle());
+    float value = 0.0f;
+    for (auto _ : state) {
+        input->setValue(value);
+        value += 1.0f;
+    }
+
+    state.counters["connections"] = static_cast<double>(scene.getConnections().size());
+}
+BENCHMARK(BM_SceneEvaluateSingleEdit)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Unit(benchmark::kMicrosecond);
+
+static void BM_SceneConnectAgainstOrder(benchmark::State& state)
+{
+    registerBenchmarkTypes();
+
+    const auto nodeCount = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Scene scene;
+        std::vector<std::shared_ptr<AddNode>> nodes;
+        for (size_t i = 0; i < nodeCount; ++i) {
+            nodes.push_back(scene.addNode(std::make_unique<AddNode>()));
+        }
+        state.ResumeTiming();
+
+        // Each connection points backwards in insertion order and forces a reorder
+        for (size_t i = nodeCount - 1; i > 0; --i) {
+            scene.addConnection(nodes[i]->outputs.result.getHandle(), nodes[i - 1]->inputs.input1.getHandle());
+        }
+        benchmark::DoNotOptimize(scene.topologicalOrder().data());
+    }
+}
+BENCHMARK(BM_SceneConnectAgainstOrder)->RangeMultiplier(4)->Range(1 << 6, 1 << 10)->Unit(benchmark::kMicrosecond);
+
+// Baseline for BM_SampleBatchEvaluate: one edit and evaluation per sample
+static void BM_SceneEvaluateSamplesOneByOne(benchmark::State& state)
+{
+    registerBenchmarkTypes();
+
+    Scene scene;
+    auto nodes = buildLayeredGraph(scene, 256);
+    scene.evaluate();
+
+    const auto sampleCount = static_cast<size_t>(state.range(0));
+    auto input = scene.getAttribute(nodes.front()->inputs.input1.getHandle());
+    for (auto _ : state) {
+        for (size_t sample = 0; sample < sampleCount; ++sample) {
+            input->setValue(static_cast<float>(sample));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sampleCount));
+}
+BENCHMARK(BM_SceneEvaluateSamplesOneByOne)->RangeMultiplier(8)->Range(1 << 6, 1 << 9)->Unit(benchmark::kMicrosecond);
+
+static void BM_SampleBatchEvaluate(benchmark::State& state)
+{
+    registerBenchmarkTypes();
+
+    Scene scene;
+    auto nodes = buildLayeredGraph(scene, 256);
+    scene.evaluate();
+
+    const auto sampleCount = static_cast<size_t>(state.range(0));
+    SampleBatch batch(scene, sampleCount);
+    auto input = batch.getLanes<float>(nodes.front()->inputs.input1.getHandle());
+    for (size_t sample = 0; sample < sampleCount; ++sample) {
+        input[sample] = static_cast<float>(sample);
+    }
+
+    for (auto _ : state) {
+        batch.evaluate();
+        benchmark::DoNotOptimize(batch.getOutput(nodes.back()->outputs.result).data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sampleCount));
+}
+BENCHMARK(BM_SampleBatchEvaluate)->RangeMultiplier(8)->Range(1 << 6, 1 << 12)->Unit(benchmark::kMicrosecond);
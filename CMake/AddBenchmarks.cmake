@@ -0,0 +1,31 @@
+function(AddBenchmarks benchmark_name)
+
+    set(options)
+    set(oneValueArgs VERSION DESCRIPTION)
+    set(multiValueArgs SOURCES BENCHMARK_LIBS PRIVATE_LIBS COMPILER_FLAGS)
+    cmake_parse_arguments(MVL "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    project(${benchmark_name}
+        VERSION ${MVL_VERSION}
+        DESCRIPTION "${MVL_DESCRIPTION}"
+        LANGUAGES CXX
+    )
+
+    add_executable(${benchmark_name} ${MVL_SOURCES})
+
+    target_compile_features(${benchmark_name} PRIVATE cxx_std_23)
+
+    if(MVL_COMPILER_FLAGS)
+        target_compile_options(${benchmark_name} PRIVATE ${MVL_COMPILER_FLAGS})
+    endif()
+
+    if(MVL_BENCHMARK_LIBS)
+        target_link_libraries(${benchmark_name} PRIVATE ${MVL_BENCHMARK_LIBS})
+    endif()
+
+    if(MVL_PRIVATE_LIBS)
+        target_link_libraries(${benchmark_name} PRIVATE ${MVL_PRIVATE_LIBS})
+    endif()
+
+    target_link_libraries(${benchmark_name} PRIVATE benchmark::benchmark benchmark::benchmark_main)
+endfunction()
@@ -0,0 +1,61 @@
+#ifndef CF_CORE_ARRAYKERNELS_HPP
+#define CF_CORE_ARRAYKERNELS_HPP
+
+#include "Core/DataTypes.hpp"
+
+#include <span>
+
+namespace cf::core {
+
+enum class SimdLevel {
+    eScalar,
+    eSSE2,
+    eAVX2
+};
+
+enum class ArrayOp {
+    eAdd,
+    eSubtract,
+    eMultiply,
+    eDivide
+};
+
+/**
+ * @brief Widest instruction set the array kernels use on this CPU, detected
+ * once on first use
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Applies op element-wise, out[i] = lhs[i] op rhs[i], with the
+ * widest kernel getSimdLevel allows. All spans must have the same size;
+ * out may alias lhs or rhs. Integer results wrap on overflow.
+ */
+void computeArray(ArrayOp op, std::span<const Float> lhs, std::span<const Float> rhs, std::span<Float> out);
+void computeArray(ArrayOp op, std::span<const Double> lhs, std::span<const Double> rhs, std::span<Double> out);
+void computeArray(ArrayOp op, std::span<const Int32> lhs, std::span<const Int32> rhs, std::span<Int32> out);
+
+/**
+ * @brief Same as computeArray, with the kernels of the given level rather
+ * than the widest one, e.g. to test or benchmark every kernel on one CPU.
+ * Throws if the level exceeds getSimdLevel.
+ */
+void computeArray(SimdLevel level, ArrayOp op, std::span<const Float> lhs, std::span<const Float> rhs, std::span<Float> out);
+void computeArray(SimdLevel level, ArrayOp op, std::span<const Double> lhs, std::span<const Double> rhs, std::span<Double> out);
+void computeArray(SimdLevel level, ArrayOp op, std::span<const Int32> lhs, std::span<const Int32> rhs, std::span<Int32> out);
+
+/**
+ * @brief Element-wise op of two arrays of the same size, as a new array
+ */
+template <typename ArrayType>
+    requires IsCoreArrayType<ArrayType>
+ArrayType computeArray(ArrayOp op, const ArrayType& lhs, const ArrayType& rhs)
+{
+    ArrayType result(lhs.size());
+    computeArray(op, std::span(lhs), std::span(rhs), std::span(result));
+    return result;
+}
+
+} // namespace cf::core
+
+#endif // CF_CORE_ARRAYKERNELS_HPP
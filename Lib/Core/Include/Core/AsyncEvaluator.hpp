@@ -0,0 +1,142 @@
+#ifndef CF_CORE_ASYNCEVALUATOR_HPP
+#define CF_CORE_ASYNCEVALUATOR_HPP
+
+#include "Core/EvaluationContext.hpp"
+#include "Core/EventBus.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cf::core {
+
+class Scene;
+
+/**
+ * @brief Immutable attribute values of a scene as of one completed
+ * evaluation. Values that did not change are shared with the previous
+ * snapshot, so publishing one costs a copy of the changed values only.
+ */
+class EvaluationSnapshot {
+public:
+    uint64_t getGeneration() const { return m_generation; }
+
+    bool contains(AttributeHandle handle) const
+    {
+        const uint32_t index = getSlotIndex(handle);
+        return index < m_values.size() && m_values[index] && m_handles[index] == handle;
+    }
+
+    template <typename Type>
+    Type getValue(AttributeHandle handle) const
+    {
+        if (!contains(handle)) {
+            throw std::runtime_error("Attribute not part of EvaluationSnapshot: " + std::to_string(handle));
+        }
+        if (m_types[getSlotIndex(handle)] != TypeRegistry::getTypeHandle<Type>()) {
+            throw std::runtime_error("Type mismatch in EvaluationSnapshot::getValue");
+        }
+
+        return *static_cast<const Type*>(m_values[getSlotIndex(handle)].get());
+    }
+
+    /**
+     * @brief Attributes whose value differs from the previous snapshot,
+     * sorted by handle: edited inputs and everything the evaluation wrote
+     */
+    const std::vector<AttributeHandle>& getChangedAttributes() const { return m_changed; }
+
+private:
+    friend class AsyncEvaluator;
+
+    uint64_t m_generation { 0 };
+    // Indexed by the slot index of the attribute handle
+    std::vector<AttributeHandle> m_handles;
+    std::vector<std::shared_ptr<const void>> m_values;
+    std::vector<TypeHandle> m_types;
+    std::vector<AttributeHandle> m_changed;
+};
+
+/**
+ * @brief Evaluates a scene on a background thread. Edits made to the scene
+ * on its own thread are forwarded to an EvaluationContext owned by the worker.
+ * An edit that arrives while an evaluation runs cancels it after the node
+ * being computed, and is coalesced with any other pending edits into the next
+ * evaluation, which resumes from the nodes left dirty. Each completed
+ * evaluation publishes a new EvaluationSnapshot.
+ *
+ * While the evaluator exists the scene itself is not evaluated on change, so
+ * results must be read from the snapshots. Topology changes are picked up on
+ * the next edit, connection event or requestEvaluation.
+ */
+class AsyncEvaluator {
+public:
+    using CompletionCallback = std::function<void(std::shared_ptr<const EvaluationSnapshot>)>;
+
+    explicit AsyncEvaluator(Scene& scene);
+    ~AsyncEvaluator();
+
+    AsyncEvaluator(const AsyncEvaluator&) = delete;
+    AsyncEvaluator& operator=(const AsyncEvaluator&) = delete;
+
+    /**
+     * @brief Called on the worker thread after every completed evaluation
+     */
+    void setCompletionCallback(CompletionCallback callback);
+
+    /**
+     * @brief Schedules an evaluation of the scene's current state. Must be
+     * called on the thread that edits the scene.
+     */
+    void requestEvaluation();
+
+    /**
+     * @brief Latest published snapshot; null until the first evaluation
+     * completes. Safe to call from any thread.
+     */
+    std::shared_ptr<const EvaluationSnapshot> getSnapshot() const;
+
+    /**
+     * @brief Blocks until every requested evaluation has completed
+     */
+    void waitUntilIdle();
+
+private:
+    void onAttributeChanged(AttributeHandle handle);
+    void workerLoop();
+    std::shared_ptr<const EvaluationSnapshot> publishSnapshot(bool isNewContext, std::vector<AttributeHandle> changed);
+
+    Scene& m_scene;
+    std::shared_ptr<const ExecutionPlan> m_plan; // Topology last handed to the worker
+
+    // Shared with the worker
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_idle;
+    std::unique_ptr<EvaluationContext> m_pendingContext;
+    std::unordered_map<AttributeHandle, std::shared_ptr<void>> m_pendingEdits;
+    CompletionCallback m_callback;
+    CancellationToken m_cancellation; // Of the evaluation in flight
+    bool m_isBusy { false };
+    bool m_stopping { false };
+
+    mutable std::mutex m_snapshotMutex;
+    std::shared_ptr<const EvaluationSnapshot> m_snapshot;
+
+    // Only touched by the worker
+    std::unique_ptr<EvaluationContext> m_context;
+    bool m_isContextPublished { false };
+    std::vector<AttributeHandle> m_unpublishedChanges; // Written by cancelled evaluations
+
+    std::vector<EventBus::SubscriptionId> m_subscriptions;
+    std::thread m_worker;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_ASYNCEVALUATOR_HPP
@@ -4,36 +4,136 @@
 #include "Core/TypeDescriptors.hpp"
 #include "Core/TypeRegistry.hpp"
 
+#include <cstddef>
+#include <unordered_set>
+
 namespace cf::core {
 
 template <typename Type>
 concept IsAttribute = std::same_as<std::remove_cvref_t<Type>, std::shared_ptr<Attribute>> || std::same_as<std::remove_cvref_t<Type>, Attribute>;
 
-using AttributeHandle = uint64_t;
+using AttributeHandle = uint64_t; // A SlotHandle into the owning scene
 static constexpr AttributeHandle kInvalidAttributeHandle = 0;
 
+/**
+ * @brief While alive, attribute change notifications raised on the current
+ * thread are appended to the given list instead of being published on the
+ * EventBus. Scopes nest; the most recently created one that is still alive
+ * receives the notifications. Scopes may be destroyed in any order, e.g. when
+ * owned by transactions of different scenes.
+ */
+class AttributeChangeCapture {
+public:
+    explicit AttributeChangeCapture(std::vector<AttributeHandle>& changes);
+    ~AttributeChangeCapture();
+
+    AttributeChangeCapture(const AttributeChangeCapture&) = delete;
+    AttributeChangeCapture& operator=(const AttributeChangeCapture&) = delete;
+
+private:
+    friend class Attribute;
+
+    std::vector<AttributeHandle>* m_changes { nullptr };
+};
+
+/**
+ * @brief While alive, attributes read and written on the current thread use
+ * the given values, indexed by the slot index of the attribute handle,
+ * instead of their own storage. Attributes without an entry keep using their
+ * own storage.
+ */
+class AttributeStorageScope {
+public:
+    explicit AttributeStorageScope(const std::vector<void*>& values);
+    ~AttributeStorageScope();
+
+    AttributeStorageScope(const AttributeStorageScope&) = delete;
+    AttributeStorageScope& operator=(const AttributeStorageScope&) = delete;
+
+private:
+    const std::vector<void*>* m_previous { nullptr };
+};
+
+/**
+ * @brief Value an attribute held before it was first written inside an
+ * AttributeEditRecorder scope
+ */
+struct AttributeEdit {
+    const Attribute* attribute { nullptr };
+    AttributeHandle handle { kInvalidAttributeHandle };
+    std::shared_ptr<void> previousValue;
+};
+
+/**
+ * @brief While alive, the first write to each attribute on the current thread
+ * saves the value it overwrites, so the writes can be reverted as a group.
+ * Writes redirected by an AttributeStorageScope are not recorded. Every
+ * recorder alive on the thread records the writes, so overlapping recorders,
+ * e.g. those of transactions on two scenes, each see the full group and may
+ * be destroyed in any order.
+ */
+class AttributeEditRecorder {
+public:
+    AttributeEditRecorder();
+    ~AttributeEditRecorder();
+
+    AttributeEditRecorder(const AttributeEditRecorder&) = delete;
+    AttributeEditRecorder& operator=(const AttributeEditRecorder&) = delete;
+
+    const std::vector<AttributeEdit>& getEdits() const { return m_edits; }
+    std::vector<AttributeEdit> takeEdits() { return std::move(m_edits); }
+
+private:
+    friend class Attribute;
+    void record(const Attribute& attribute, const void* value);
+
+    std::vector<AttributeEdit> m_edits;
+    std::unordered_set<const Attribute*> m_recorded;
+};
+
 /**
  * @brief Attribute is a type erased container for different basic data types
  * used in the application
  *
+ * The attribute keeps its type handle and pointers to its descriptors, so
+ * reads and writes do not look anything up in the TypeRegistry. Attributes
+ * must therefore not outlive TypeRegistry::clearInstance.
+ *
+ * Values of up to kInlineStorageSize bytes are stored inside the attribute;
+ * only larger or over-aligned types are allocated on the heap.
  */
 class Attribute {
 public:
     Attribute();
     // TODO: Is the handle necessary here? Can we simplify this?
-    Attribute(AttributeDescriptor desc, AttributeHandle attributeHandle);
+    Attribute(const AttributeDescriptor& desc, AttributeHandle attributeHandle);
+
+    /**
+     * @brief Attribute whose value lives in storage owned by the caller, e.g.
+     * a scene's AttributeStorage. The storage must hold a constructed value
+     * of the attribute's type and outlive every read of the attribute; the
+     * attribute never destroys it.
+     */
+    Attribute(const AttributeDescriptor& desc, AttributeHandle attributeHandle, void* storage);
     ~Attribute();
 
+    // The value may live inside the attribute, so it cannot be copied or moved
+    Attribute(const Attribute&) = delete;
+    Attribute& operator=(const Attribute&) = delete;
+
+    static constexpr size_t kInlineStorageSize = 32;
+
     template <typename Type>
     Type getValue() const
     {
-        if (!data)
+        const void* value = resolveReadData();
+        if (!value)
             throw std::runtime_error("Null data pointer in Attribute::getValue");
 
-        if (getTypeHandle() != TypeRegistry::getTypeHandle<Type>())
+        if (m_typeHandle != TypeRegistry::getTypeHandle<Type>())
             throw std::runtime_error("Type mismatch in Attribute::getValue");
 
-        return *static_cast<Type*>(data);
+        return *static_cast<const Type*>(value);
     }
 
     template <typename Type>
@@ -46,16 +146,74 @@ public:
         }
     }
 
+    /**
+     * @brief Copies a value of the attribute's type, given as raw storage,
+     * into the attribute and publishes the change
+     */
+    void setRawValue(const void* value);
+
     AttributeHandle getHandle() const;
-    AttributeDescriptor getAttributeDescriptor() const;
+    const AttributeDescriptor& getAttributeDescriptor() const;
+    TypeHandle getTypeHandle() const { return m_typeHandle; }
+    const TypeDescriptor& getTypeDescriptor() const { return *m_typeDescriptor; }
+    bool isValueInline() const { return data == m_inlineStorage; }
+
+    /**
+     * @brief Moves the value out of caller-owned storage into the attribute,
+     * e.g. before a scene releases the storage of a removed node
+     *
+     * @return the storage the value was moved out of, still holding a
+     * constructed value, or nullptr if the attribute already owned its value
+     */
+    void* detachStorage();
+
+    /**
+     * @brief Moves the value into caller-owned storage holding a constructed
+     * value of the attribute's type; the inverse of detachStorage
+     */
+    void attachStorage(void* storage);
+
+    /**
+     * @brief Makes the attribute read its value from the source's storage
+     * instead of holding a copy of it, as a connected input does. Writes still
+     * go to the attribute's own storage. Clearing the source with nullptr
+     * keeps the last value read from it. Throws if the source's type differs.
+     */
+    void setSource(const Attribute* source);
+    const Attribute* getSource() const { return m_source; }
+
+    /**
+     * @brief Storage the value is read from: the source's when one is set.
+     * Follows any active AttributeStorageScope.
+     */
+    const void* getValueData() const { return resolveReadData(); }
+
+    /**
+     * @brief Raw storage of the value, for callers that resolved its type up
+     * front. Writes through it do not publish change events, and it ignores
+     * any active AttributeStorageScope.
+     */
+    void* getData() { return data; }
+    const void* getData() const { return data; }
 
 private:
     AttributeHandle m_handle { kInvalidAttributeHandle };
     AttributeDescriptorHandle m_descriptorHandle { kInvalidAttributeHandle };
     void* data { nullptr };
+    const Attribute* m_source { nullptr };
+
+    TypeHandle m_typeHandle { kInvalidTypeHandle };
+    const AttributeDescriptor* m_descriptor { nullptr }; // Null if not registered when the attribute was created
+    const TypeDescriptor* m_typeDescriptor { nullptr };
+    bool m_ownsValue { true };
+
+    alignas(std::max_align_t) std::byte m_inlineStorage[kInlineStorageSize];
 
+    void createOwnedValue(); // Inline when the type fits
     void publishAttributeChanged(AttributeHandle handle);
-    TypeHandle getTypeHandle() const;
+    void* resolveData() const;
+    const void* resolveReadData() const;
+    void recordWrite(const void* currentValue) const;
 
     void copyDataFrom(const std::shared_ptr<Attribute>& other);
     void copyDataFrom(const Attribute& other);
@@ -63,14 +221,16 @@ private:
     template <typename Type>
     void copyDataFromPrimitive(const Type& value)
     {
-        if (!data) {
+        void* target = resolveData();
+        if (!target) {
             throw std::runtime_error("Null data pointer in copyDataFromPrimitive");
         }
-        if (getTypeHandle() != TypeRegistry::getTypeHandle<Type>()) {
+        if (m_typeHandle != TypeRegistry::getTypeHandle<Type>()) {
             throw std::runtime_error("Type mismatch in copyDataFromPrimitive");
         }
 
-        *static_cast<Type*>(data) = value;
+        recordWrite(target);
+        *static_cast<Type*>(target) = value;
         publishAttributeChanged(m_handle);
     }
 };
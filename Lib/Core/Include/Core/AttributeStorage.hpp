@@ -0,0 +1,69 @@
+#ifndef CF_CORE_ATTRIBUTESTORAGE_HPP
+#define CF_CORE_ATTRIBUTESTORAGE_HPP
+
+#include "Core/TypeDescriptors.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cf::core {
+
+/**
+ * @brief Values of a scene's attributes, laid out per type in contiguous
+ * columns. Column memory is carved from an arena owned by the storage and
+ * released in one go when the storage is destroyed.
+ *
+ * Columns grow in fixed-size chunks, so values never move once allocated and
+ * attributes can keep pointing at theirs. Released slots are reused by the
+ * next value of the same type.
+ */
+class AttributeStorage {
+public:
+    AttributeStorage() = default;
+    ~AttributeStorage();
+
+    AttributeStorage(const AttributeStorage&) = delete;
+    AttributeStorage& operator=(const AttributeStorage&) = delete;
+
+    /**
+     * @brief Default constructs a value of the type in its column
+     */
+    void* allocate(TypeHandle typeHandle);
+
+    /**
+     * @brief Destroys a value returned by allocate and frees its slot
+     */
+    void release(TypeHandle typeHandle, void* value);
+
+    /**
+     * @brief Number of live values of the type
+     */
+    size_t getValueCount(TypeHandle typeHandle) const;
+
+    static constexpr uint32_t kChunkCapacity = 256; // Values per chunk
+
+private:
+    struct Column {
+        const TypeDescriptor* type { nullptr };
+        std::vector<std::byte*> chunks;
+        std::vector<std::pair<const std::byte*, uint32_t>> chunksByAddress; // Sorted, for release
+        std::vector<bool> isLive; // Per slot
+        std::vector<uint32_t> freeSlots;
+        size_t liveCount { 0 };
+
+        std::byte* getSlot(uint32_t index) const { return chunks[index / kChunkCapacity] + (index % kChunkCapacity) * type->size; }
+    };
+
+    uint32_t findSlot(const Column& column, const void* value) const;
+
+    std::pmr::monotonic_buffer_resource m_arena;
+    std::unordered_map<TypeHandle, Column> m_columns;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_ATTRIBUTESTORAGE_HPP
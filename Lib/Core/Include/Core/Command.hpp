@@ -7,6 +7,12 @@ public:
     virtual ~Command() = default;
     virtual void execute() = 0;
     virtual void undo() = 0;
+
+    /**
+     * @brief Whether the last execute changed anything. The UndoStack drops
+     * commands whose first execute did not, e.g. a rejected connection.
+     */
+    virtual bool hasEffect() const { return true; }
 };
 
 } // namespace cf::core
@@ -17,29 +17,31 @@ public:
         : m_scene(scene), m_fromAttr(fromAttr), m_toAttr(toAttr) {}
     
     void execute() override {
-        if (!m_connectionCreated) {
-            m_scene->addConnection(m_fromAttr, m_toAttr);
-            m_connectionCreated = true;
-
-            EventBus::publish(ConnectionAddedEvent(m_fromAttr, m_toAttr));
-        } else {
-            // Restore connection if it was previously undone
-            m_scene->addConnection(m_fromAttr, m_toAttr);
-            
+        // The scene rejects duplicates, cycles and incompatible attributes
+        m_isConnected = m_scene->addConnection(m_fromAttr, m_toAttr);
+        if (m_isConnected) {
             EventBus::publish(ConnectionAddedEvent(m_fromAttr, m_toAttr));
         }
     }
     
     void undo() override {
+        // A rejected connection may duplicate an existing one, which must stay
+        if (!m_isConnected) {
+            return;
+        }
+
         m_scene->removeConnection(m_fromAttr, m_toAttr);
+        m_isConnected = false;
         EventBus::publish(ConnectionRemovedEvent(m_fromAttr, m_toAttr));
     }
+
+    bool hasEffect() const override { return m_isConnected; }
     
 private:
     std::shared_ptr<Scene> m_scene;
     AttributeHandle m_fromAttr;
     AttributeHandle m_toAttr;
-    bool m_connectionCreated = false;
+    bool m_isConnected = false;
 };
 
 }   // namespace cf::core
@@ -0,0 +1,45 @@
+#ifndef CF_CORE_COMMANDS_REMOVENODESCOMMAND_HPP
+#define CF_CORE_COMMANDS_REMOVENODESCOMMAND_HPP
+
+#include "Core/Command.hpp"
+#include "Core/Scene.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace cf::core {
+
+/**
+ * @brief Removes nodes, with their attributes and connections, from a scene.
+ * Undo restores them under their original handles, so commands further down
+ * the stack that refer to them stay valid.
+ */
+class RemoveNodesCommand : public Command {
+public:
+    RemoveNodesCommand(std::shared_ptr<Scene> scene, std::vector<NodeHandle> handles)
+        : m_scene(std::move(scene))
+        , m_handles(std::move(handles))
+    {
+    }
+
+    void execute() override
+    {
+        m_removed = m_scene->removeNodes(m_handles);
+    }
+
+    void undo() override
+    {
+        if (m_scene->restoreNodes(m_removed)) {
+            m_removed = {};
+        }
+    }
+
+private:
+    std::shared_ptr<Scene> m_scene;
+    std::vector<NodeHandle> m_handles;
+    RemovedNodes m_removed;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_COMMANDS_REMOVENODESCOMMAND_HPP
@@ -0,0 +1,67 @@
+#ifndef CF_CORE_COMMANDS_SETATTRIBUTESCOMMAND_HPP
+#define CF_CORE_COMMANDS_SETATTRIBUTESCOMMAND_HPP
+
+#include "Core/Command.hpp"
+#include "Core/Scene.hpp"
+#include "Core/SceneTransaction.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace cf::core {
+
+/**
+ * @brief Undo entry for the attribute edits of a committed SceneTransaction.
+ * The edits are already applied when the command is pushed, so the first
+ * execute does nothing. Attributes removed from the scene since are skipped.
+ */
+class SetAttributesCommand : public Command {
+public:
+    SetAttributesCommand(std::shared_ptr<Scene> scene, std::vector<AttributeEdit> edits)
+        : m_scene(std::move(scene))
+        , m_edits(std::move(edits))
+    {
+        m_newValues.reserve(m_edits.size());
+        for (const auto& edit : m_edits) {
+            const TypeDescriptor& desc = m_scene->getAttribute(edit.handle)->getTypeDescriptor();
+            std::shared_ptr<void> value(desc.create(), desc.destroy);
+            desc.copy(value.get(), m_scene->getAttribute(edit.handle)->getData());
+            m_newValues.push_back(std::move(value));
+        }
+    }
+
+    void execute() override
+    {
+        if (!m_isApplied) {
+            m_isApplied = true;
+            return;
+        }
+
+        SceneTransaction transaction(*m_scene);
+        for (size_t i = 0; i < m_edits.size(); ++i) {
+            if (auto attribute = m_scene->getAttribute(m_edits[i].handle)) {
+                attribute->setRawValue(m_newValues[i].get());
+            }
+        }
+    }
+
+    void undo() override
+    {
+        SceneTransaction transaction(*m_scene);
+        for (const auto& edit : m_edits) {
+            if (auto attribute = m_scene->getAttribute(edit.handle)) {
+                attribute->setRawValue(edit.previousValue.get());
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<Scene> m_scene;
+    std::vector<AttributeEdit> m_edits;
+    std::vector<std::shared_ptr<void>> m_newValues;
+    bool m_isApplied = false;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_COMMANDS_SETATTRIBUTESCOMMAND_HPP
@@ -1,8 +1,14 @@
 #ifndef CF_CORE_DATATYPES_HPP
 #define CF_CORE_DATATYPES_HPP
 
+#include "Core/SharedValue.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace cf::core {
 
@@ -18,9 +24,56 @@ using Double = double;
 
 using String = std::string;
 
+// Contiguous per-element values, e.g. one per point or sample
+using FloatArray = std::vector<Float>;
+using DoubleArray = std::vector<Double>;
+using Int32Array = std::vector<Int32>;
+
+// Copy-on-write array values, for large arrays that undo snapshots, result
+// caches and evaluation contexts should share rather than copy. The plain
+// array types stay the ones the kernels and InputAttribute operators take.
+using SharedFloatArray = SharedValue<FloatArray>;
+using SharedDoubleArray = SharedValue<DoubleArray>;
+using SharedInt32Array = SharedValue<Int32Array>;
+
+// Fixed-size math types. Vec4, Quat and Mat4 are vectorized by Eigen and so
+// over-aligned; TypeDescriptor::create keeps them aligned on the heap.
+using Vec2 = Eigen::Vector2f;
+using Vec3 = Eigen::Vector3f;
+using Vec4 = Eigen::Vector4f;
+using Quat = Eigen::Quaternionf;
+using Mat3 = Eigen::Matrix3f;
+using Mat4 = Eigen::Matrix4f;
+
 template <typename T>
 concept IsCoreFundamentalType = std::same_as<T, Bool> || std::same_as<T, Int32> || std::same_as<T, UInt32> || std::same_as<T, Int64> || std::same_as<T, UInt64> || std::same_as<T, Float> || std::same_as<T, Double> || std::same_as<T, String>;
 
+template <typename T>
+concept IsCoreArrayType = std::same_as<T, FloatArray> || std::same_as<T, DoubleArray> || std::same_as<T, Int32Array>;
+
+template <typename T>
+concept IsCoreSharedArrayType = std::same_as<T, SharedFloatArray> || std::same_as<T, SharedDoubleArray> || std::same_as<T, SharedInt32Array>;
+
+template <typename T>
+concept IsCoreMathType = std::same_as<T, Vec2> || std::same_as<T, Vec3> || std::same_as<T, Vec4> || std::same_as<T, Quat> || std::same_as<T, Mat3> || std::same_as<T, Mat4>;
+
+/**
+ * @brief Value a new attribute of the type starts with. Eigen leaves its
+ * types uninitialized, so vectors start at zero and rotations and matrices
+ * at identity.
+ */
+template <typename T>
+T makeDefaultValue()
+{
+    if constexpr (std::same_as<T, Vec2> || std::same_as<T, Vec3> || std::same_as<T, Vec4>) {
+        return T::Zero();
+    } else if constexpr (IsCoreMathType<T>) {
+        return T::Identity();
+    } else {
+        return T {};
+    }
+}
+
 } // namespace cf::core
 
 #endif // CF_CORE_DATATYPES_HPP
\ No newline at end of file
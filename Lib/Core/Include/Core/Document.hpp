@@ -2,6 +2,7 @@
 #define CF_CORE_DOCUMENT_HPP
 
 #include "Core/Scene.hpp"
+#include "Core/SceneTransaction.hpp"
 #include "Core/UndoStack.hpp"
 
 namespace cf::core {
@@ -12,6 +13,12 @@ public:
 
     UndoStack& getUndoStack() { return m_undoRedoManager; }
 
+    /**
+     * @brief Groups the edits made to the current scene until the returned
+     * transaction commits into one evaluation and one undo entry
+     */
+    SceneTransaction beginTransaction() { return SceneTransaction(m_scene, m_undoRedoManager); }
+
 private:
     std::shared_ptr<Scene> m_scene;
     UndoStack m_undoRedoManager;
@@ -0,0 +1,124 @@
+#ifndef CF_CORE_EVALUATIONCONTEXT_HPP
+#define CF_CORE_EVALUATIONCONTEXT_HPP
+
+#include "Core/Attribute.hpp"
+#include "Core/EvaluationControl.hpp"
+#include "Core/ExecutionPlan.hpp"
+#include "Core/Node.hpp"
+#include "Core/SlotMap.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace cf::core {
+
+class Scene;
+
+/**
+ * @brief Independent set of attribute values for a scene's graph. The context
+ * shares the scene's nodes and compiled topology, but reads and writes only
+ * its own copy of every attribute value, so several contexts, e.g. one per
+ * frame, can evaluate concurrently on different threads.
+ *
+ * A context is created from the scene on the thread that edits it and starts
+ * with the scene's current values and dirty state. It keeps evaluating the
+ * topology it was created with; contexts must be recreated after nodes or
+ * connections change. Nodes computed through a context must not modify any
+ * state other than their outputs.
+ */
+class EvaluationContext {
+public:
+    explicit EvaluationContext(Scene& scene);
+    ~EvaluationContext();
+
+    EvaluationContext(const EvaluationContext&) = delete;
+    EvaluationContext& operator=(const EvaluationContext&) = delete;
+
+    template <typename Type>
+    Type getValue(AttributeHandle handle) const
+    {
+        return *static_cast<const Type*>(getStorage(handle, TypeRegistry::getTypeHandle<Type>()));
+    }
+
+    /**
+     * @brief Sets the context's value of an attribute and marks its node, and
+     * everything downstream of it, dirty in this context only. A connected
+     * input keeps reading the output feeding it.
+     */
+    template <typename Type>
+    void setValue(AttributeHandle handle, const Type& value)
+    {
+        *static_cast<Type*>(getOwnedStorage(handle, TypeRegistry::getTypeHandle<Type>())) = value;
+        markStepDirty(m_attributeSteps[getSlotIndex(handle)]);
+    }
+
+    /**
+     * @brief Type-erased setValue, for values whose type was resolved up front
+     */
+    void setRawValue(AttributeHandle handle, const void* value);
+
+    /**
+     * @brief The context's value of an attribute, or nullptr if the attribute
+     * is not part of the context
+     */
+    const void* findRawValue(AttributeHandle handle) const;
+
+    template <typename Func>
+    void forEachValue(Func&& func) const
+    {
+        for (uint32_t index = 0; index < m_values.size(); ++index) {
+            if (m_values[index]) {
+                func(m_handles[index], m_types[index], static_cast<const void*>(m_values[index]));
+            }
+        }
+    }
+
+    /**
+     * @brief Recomputes the nodes dirty in this context, serially on the
+     * calling thread. Change notifications are not published; the attributes
+     * written are listed by getChangedAttributes until the next evaluation.
+     */
+    EvaluationStatus evaluate();
+
+    /**
+     * @brief Same as evaluate, but stops between node computes once the token
+     * is cancelled or the budget runs out, leaving the remaining nodes dirty
+     */
+    EvaluationStatus evaluate(const CancellationToken& token,
+        std::optional<std::chrono::steady_clock::duration> budget = std::nullopt);
+
+    const std::vector<AttributeHandle>& getChangedAttributes() const { return m_changes; }
+    const std::shared_ptr<const ExecutionPlan>& getExecutionPlan() const { return m_plan; }
+
+    bool isDirty(NodeHandle nodeHandle) const;
+    size_t getDirtyNodeCount() const { return m_dirtyCount; }
+
+private:
+    EvaluationStatus evaluateDirty(const EvaluationStopCondition& stopCondition);
+    void* getStorage(AttributeHandle handle, TypeHandle typeHandle) const;
+    void* getOwnedStorage(AttributeHandle handle, TypeHandle typeHandle) const;
+    bool contains(AttributeHandle handle) const;
+    void markStepDirty(uint32_t stepIndex);
+
+    std::shared_ptr<const ExecutionPlan> m_plan;
+
+    // Indexed by the slot index of the attribute handle; slots without an
+    // attribute have no value and m_handles tells stale handles apart.
+    // A connected input reads the storage of the output feeding it, so its
+    // entry in m_values points into another attribute's owned value.
+    std::vector<AttributeHandle> m_handles;
+    std::vector<void*> m_values;
+    std::vector<void*> m_ownedValues;
+    std::vector<TypeHandle> m_types;
+    std::vector<uint32_t> m_attributeSteps;
+
+    std::vector<bool> m_dirtySteps;
+    size_t m_dirtyCount { 0 };
+
+    std::vector<AttributeHandle> m_changes;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_EVALUATIONCONTEXT_HPP
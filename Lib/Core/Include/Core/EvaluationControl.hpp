@@ -0,0 +1,77 @@
+#ifndef CF_CORE_EVALUATIONCONTROL_HPP
+#define CF_CORE_EVALUATIONCONTROL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+
+namespace cf::core {
+
+enum class EvaluationStatus {
+    eComplete, // Every dirty node was computed
+    eCancelled, // Stopped by a CancellationToken; the nodes not reached are still dirty
+    eOutOfTime, // Stopped by the time budget; the nodes not reached are still dirty
+    eDeferred // Nothing was computed, as an evaluation or transaction is in progress
+};
+
+/**
+ * @brief Shared flag asking an evaluation to stop. Copies refer to the same
+ * flag, so a token can be cancelled from a different thread than the one
+ * evaluating.
+ */
+class CancellationToken {
+public:
+    CancellationToken()
+        : m_isCancelled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    void cancel() const { m_isCancelled->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return m_isCancelled->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_isCancelled;
+};
+
+/**
+ * @brief Token and deadline an evaluation checks between node computes. The
+ * deadline is only checked once a node has been computed, so every
+ * evaluation that is not cancelled makes progress.
+ */
+class EvaluationStopCondition {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    EvaluationStopCondition() = default;
+
+    EvaluationStopCondition(const CancellationToken* token, std::optional<Clock::duration> budget)
+        : m_token(token)
+    {
+        if (budget) {
+            m_deadline = Clock::now() + *budget;
+        }
+    }
+
+    /**
+     * @brief Reason to stop before the next compute, or eComplete to go on
+     */
+    EvaluationStatus check(bool hasComputed) const
+    {
+        if (m_token && m_token->isCancelled()) {
+            return EvaluationStatus::eCancelled;
+        }
+        if (m_deadline && hasComputed && Clock::now() >= *m_deadline) {
+            return EvaluationStatus::eOutOfTime;
+        }
+        return EvaluationStatus::eComplete;
+    }
+
+private:
+    const CancellationToken* m_token { nullptr };
+    std::optional<Clock::time_point> m_deadline;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_EVALUATIONCONTROL_HPP
@@ -59,7 +59,7 @@ struct EventBus {
             std::is_base_of_v<Event, EventType>,
             "EventType must be derived from Event");
 
-        SubscriptionId id = m_subscriptionId++;
+        SubscriptionId id = ++m_subscriptionId;
         auto& callbacks = m_callbacks[typeid(EventType)];
         callbacks.emplace_back(id, [callback = std::move(callback)](const Event& event) {
             callback(static_cast<const EventType&>(event));
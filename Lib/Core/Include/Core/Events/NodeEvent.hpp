@@ -0,0 +1,38 @@
+#ifndef CF_CORE_EVENTS_NODEEVENT_HPP
+#define CF_CORE_EVENTS_NODEEVENT_HPP
+
+#include "Core/Attribute.hpp"
+#include "Core/EventBus.hpp"
+#include "Core/Node.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace cf::core {
+
+/**
+ * @brief Published once per Scene::removeNodes or Scene::restoreNodes call,
+ * however many nodes it covers
+ */
+struct NodeEvent : public Event {
+    enum class NodeMessage {
+        eNodesRemoved,
+        eNodesRestored
+    };
+
+    NodeEvent(NodeMessage msg, std::vector<NodeHandle> nodeHandles,
+        std::vector<std::pair<AttributeHandle, AttributeHandle>> connectionHandles)
+        : m_message(msg)
+        , nodes(std::move(nodeHandles))
+        , connections(std::move(connectionHandles))
+    {
+    }
+
+    NodeMessage m_message;
+    std::vector<NodeHandle> nodes;
+    std::vector<std::pair<AttributeHandle, AttributeHandle>> connections; // Source and target attributes
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_EVENTS_NODEEVENT_HPP
@@ -0,0 +1,77 @@
+#ifndef CF_CORE_EXECUTIONPLAN_HPP
+#define CF_CORE_EXECUTIONPLAN_HPP
+
+#include "Core/Attribute.hpp"
+#include "Core/Node.hpp"
+#include "Core/ResultCache.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace cf::core {
+
+class Scene;
+
+using CopyFunc = TypeDescriptor::CopyFunc;
+
+/**
+ * @brief One connected input of a step and the output feeding it. The input
+ * reads the output's storage directly, so nothing is copied along a link;
+ * it only tells which inputs change when their source does.
+ */
+struct ExecutionLink {
+    AttributeHandle targetHandle { kInvalidAttributeHandle };
+    AttributeHandle sourceHandle { kInvalidAttributeHandle };
+};
+
+/**
+ * @brief One node of the plan: the connections it reads from, and the steps
+ * that depend on it
+ */
+struct ExecutionStep {
+    NodeHandle handle { kInvalidNodeHandle };
+    Node* node { nullptr };
+    ResultCache* cache { nullptr }; // Owned by the scene, set for node types with a result cache
+
+    uint32_t firstLink { 0 };
+    uint32_t linkCount { 0 };
+
+    uint32_t firstSuccessor { 0 };
+    uint32_t successorCount { 0 };
+};
+
+/**
+ * @brief Flat, topologically ordered form of a Scene's graph. Evaluating the
+ * scene replays the steps without touching the scene's maps or the
+ * TypeRegistry. A plan is only valid until the scene's topology changes.
+ */
+struct ExecutionPlan {
+    std::vector<ExecutionStep> steps;
+    std::vector<ExecutionLink> links;
+    std::vector<uint32_t> successors; // Step indices, ranges owned by the steps
+
+    // Keeps the steps' nodes alive for holders of the plan, such as an
+    // EvaluationContext, after the scene removed them
+    std::vector<std::shared_ptr<Node>> nodes;
+
+    std::unordered_map<NodeHandle, uint32_t> stepIndex;
+
+    static ExecutionPlan compile(const Scene& scene);
+
+    /**
+     * @brief Reports the step's connected inputs as changed, as their
+     * sources are recomputed before the step runs
+     */
+    void collectLinkChanges(const ExecutionStep& step, std::vector<AttributeHandle>& changes) const
+    {
+        for (uint32_t i = step.firstLink; i < step.firstLink + step.linkCount; ++i) {
+            changes.push_back(links[i].targetHandle);
+        }
+    }
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_EXECUTIONPLAN_HPP
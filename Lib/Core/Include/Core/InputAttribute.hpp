@@ -1,8 +1,11 @@
 #ifndef CF_CORE_INPUTATTRIBUTE_HPP
 #define CF_CORE_INPUTATTRIBUTE_HPP
 
+#include "Core/ArrayKernels.hpp"
 #include "Core/TypedAttribute.hpp"
 
+#include <algorithm>
+
 namespace cf::core {
 
 /**
@@ -10,6 +13,9 @@ namespace cf::core {
  * a node. Input attributes are used to read data from the graph context. Inputs
  * are read-only and cannot be modified directly.
  *
+ * Arithmetic on array types is element-wise and runs vectorized kernels, see
+ * computeArray.
+ *
  * @tparam DataType
  */
 template <typename DataType>
@@ -23,26 +29,47 @@ struct InputAttribute : public TypedAttribute<DataType> {
 
     DataType operator+(const InputAttribute& other) const
     {
-        return this->getValue() + other.getValue();
+        if constexpr (IsCoreArrayType<DataType>) {
+            return computeArray(ArrayOp::eAdd, this->getValueRef(), other.getValueRef());
+        } else {
+            return this->getValue() + other.getValue();
+        }
     }
 
     DataType operator-(const InputAttribute& other) const
     {
-        return this->getValue() - other.getValue();
+        if constexpr (IsCoreArrayType<DataType>) {
+            return computeArray(ArrayOp::eSubtract, this->getValueRef(), other.getValueRef());
+        } else {
+            return this->getValue() - other.getValue();
+        }
     }
 
     template <typename OtherType>
     DataType operator*(const InputAttribute<OtherType>& other) const
     {
-        return this->getValue() * other.getValue();
+        if constexpr (IsCoreArrayType<DataType>) {
+            static_assert(std::same_as<DataType, OtherType>, "Arrays multiply element-wise with arrays of the same type");
+            return computeArray(ArrayOp::eMultiply, this->getValueRef(), other.getValueRef());
+        } else {
+            return this->getValue() * other.getValue();
+        }
     }
 
     DataType operator/(const InputAttribute& other) const
     {
-        if (other.getValue() == 0) {
-            throw std::runtime_error("Division by zero in InputAttribute");
+        if constexpr (IsCoreArrayType<DataType>) {
+            const DataType& divisor = other.getValueRef();
+            if (std::ranges::find(divisor, typename DataType::value_type {}) != divisor.end()) {
+                throw std::runtime_error("Division by zero in InputAttribute");
+            }
+            return computeArray(ArrayOp::eDivide, this->getValueRef(), divisor);
+        } else {
+            if (other.getValue() == 0) {
+                throw std::runtime_error("Division by zero in InputAttribute");
+            }
+            return this->getValue() / other.getValue();
         }
-        return this->getValue() / other.getValue();
     }
 };
 
@@ -8,12 +8,14 @@
 
 namespace cf::core {
 
+class SampleBatch;
+
 enum class Status {
     eOK,
     eError
 };
 
-using NodeHandle = uint64_t;
+using NodeHandle = uint64_t; // A SlotHandle into the owning scene
 static constexpr NodeHandle kInvalidNodeHandle = 0;
 
 template <typename NodeType>
@@ -29,13 +31,26 @@ public:
     virtual Status compute() = 0;
     virtual TypeHandle getType() const = 0;
 
+    /**
+     * @brief Nodes that can compute every sample of a SampleBatch in one call
+     * override both of these. Other nodes are computed once per sample.
+     */
+    virtual bool hasBatchCompute() const { return false; }
+    virtual Status computeBatch(SampleBatch& batch)
+    {
+        (void)batch;
+        return Status::eError;
+    }
+
     NodeHandle getHandle() const { return m_handle; }
-    NodeDescriptor getDescriptor() const { return TypeRegistry::getNodeDescriptor(getType()); }
+    const NodeDescriptor& getDescriptor() const { return TypeRegistry::getNodeDescriptor(getType()); }
 
     std::string getName() const { return m_name; }
     void setName(const std::string& name) { m_name = name; }
 
 private:
+    friend class Scene; // Assigns the handle when the node is added
+
     NodeHandle m_handle = kInvalidNodeHandle;
     std::string m_name = "Unnamed Node";
 };
@@ -23,6 +23,9 @@ public:
 
     Status compute() override;
 
+    bool hasBatchCompute() const override { return true; }
+    Status computeBatch(SampleBatch& batch) override;
+
     static NodeDescriptor initialize()
     {
         NodeDescriptor descriptor;
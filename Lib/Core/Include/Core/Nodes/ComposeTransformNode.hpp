@@ -0,0 +1,55 @@
+#ifndef CF_CORE_NODES_COMPOSETRANSFORMNODE_HPP
+#define CF_CORE_NODES_COMPOSETRANSFORMNODE_HPP
+
+#include "Core/DataTypes.hpp"
+#include "Core/InputAttribute.hpp"
+#include "Core/Node.hpp"
+#include "Core/OutputAttribute.hpp"
+
+namespace cf::core {
+
+/**
+ * @brief Affine transform that scales, then rotates, then translates
+ */
+class ComposeTransformNode : public NodeBase<ComposeTransformNode> {
+public:
+    struct Inputs {
+        InputAttribute<Vec3> translation;
+        InputAttribute<Quat> rotation;
+        InputAttribute<Vec3> scale;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<Mat4> transform;
+    } outputs;
+
+    ComposeTransformNode() = default;
+    ~ComposeTransformNode() override = default;
+
+    Status compute() override;
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "Compose Transform Node";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::translation,
+            "Translation"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::rotation,
+            "Rotation"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::scale,
+            "Scale"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(
+            &Outputs::transform,
+            "Transform"));
+
+        return descriptor;
+    }
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_NODES_COMPOSETRANSFORMNODE_HPP
@@ -0,0 +1,51 @@
+#ifndef CF_CORE_NODES_MULTIPLYMATRIXNODE_HPP
+#define CF_CORE_NODES_MULTIPLYMATRIXNODE_HPP
+
+#include "Core/DataTypes.hpp"
+#include "Core/InputAttribute.hpp"
+#include "Core/Node.hpp"
+#include "Core/OutputAttribute.hpp"
+
+namespace cf::core {
+
+/**
+ * @brief Product of two transforms; the right one is applied first
+ */
+class MultiplyMatrixNode : public NodeBase<MultiplyMatrixNode> {
+public:
+    struct Inputs {
+        InputAttribute<Mat4> lhs;
+        InputAttribute<Mat4> rhs;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<Mat4> result;
+    } outputs;
+
+    MultiplyMatrixNode() = default;
+    ~MultiplyMatrixNode() override = default;
+
+    Status compute() override;
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "Multiply Matrix Node";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::lhs,
+            "Left"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::rhs,
+            "Right"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(
+            &Outputs::result,
+            "Result"));
+
+        return descriptor;
+    }
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_NODES_MULTIPLYMATRIXNODE_HPP
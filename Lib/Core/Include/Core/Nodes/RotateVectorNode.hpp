@@ -0,0 +1,51 @@
+#ifndef CF_CORE_NODES_ROTATEVECTORNODE_HPP
+#define CF_CORE_NODES_ROTATEVECTORNODE_HPP
+
+#include "Core/DataTypes.hpp"
+#include "Core/InputAttribute.hpp"
+#include "Core/Node.hpp"
+#include "Core/OutputAttribute.hpp"
+
+namespace cf::core {
+
+/**
+ * @brief Rotates a direction by a quaternion, normalized first
+ */
+class RotateVectorNode : public NodeBase<RotateVectorNode> {
+public:
+    struct Inputs {
+        InputAttribute<Quat> rotation;
+        InputAttribute<Vec3> vector;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<Vec3> result;
+    } outputs;
+
+    RotateVectorNode() = default;
+    ~RotateVectorNode() override = default;
+
+    Status compute() override;
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "Rotate Vector Node";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::rotation,
+            "Rotation"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::vector,
+            "Vector"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(
+            &Outputs::result,
+            "Result"));
+
+        return descriptor;
+    }
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_NODES_ROTATEVECTORNODE_HPP
@@ -0,0 +1,54 @@
+#ifndef CF_CORE_NODES_TRANSFORMPOINTNODE_HPP
+#define CF_CORE_NODES_TRANSFORMPOINTNODE_HPP
+
+#include "Core/DataTypes.hpp"
+#include "Core/InputAttribute.hpp"
+#include "Core/Node.hpp"
+#include "Core/OutputAttribute.hpp"
+
+namespace cf::core {
+
+/**
+ * @brief Applies an affine transform to a point
+ */
+class TransformPointNode : public NodeBase<TransformPointNode> {
+public:
+    struct Inputs {
+        InputAttribute<Mat4> transform;
+        InputAttribute<Vec3> point;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<Vec3> result;
+    } outputs;
+
+    TransformPointNode() = default;
+    ~TransformPointNode() override = default;
+
+    Status compute() override;
+
+    bool hasBatchCompute() const override { return true; }
+    Status computeBatch(SampleBatch& batch) override;
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "Transform Point Node";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::transform,
+            "Transform"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(
+            &Inputs::point,
+            "Point"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(
+            &Outputs::result,
+            "Result"));
+
+        return descriptor;
+    }
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_NODES_TRANSFORMPOINTNODE_HPP
@@ -0,0 +1,78 @@
+#ifndef CF_CORE_RESULTCACHE_HPP
+#define CF_CORE_RESULTCACHE_HPP
+
+#include "Core/Attribute.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cf::core {
+
+struct ResultCacheStats {
+    uint64_t hits { 0 };
+    uint64_t misses { 0 };
+};
+
+/**
+ * @brief Output values of one node for its most recently seen input values.
+ * Entries are looked up by a hash of every input value and keep a copy of the
+ * inputs, so that a hash collision is not taken for a hit. The node must be
+ * pure: its outputs may only depend on its inputs.
+ */
+class ResultCache {
+public:
+    ResultCache(std::vector<Attribute*> inputs, std::vector<Attribute*> outputs, size_t capacity);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    /**
+     * @brief Whether every input type provides TypeDescriptor::hash and
+     * TypeDescriptor::equal
+     */
+    static bool canHash(const std::vector<Attribute*>& inputs);
+
+    uint64_t hashInputs() const;
+
+    /**
+     * @brief Writes the outputs stored for the node's current input values,
+     * which hash to `inputHash`, into the node's output attributes,
+     * publishing the changes as a compute would
+     *
+     * @return false if no entry holds the same input values
+     */
+    bool restore(uint64_t inputHash);
+
+    /**
+     * @brief Saves the node's current outputs for its current input values,
+     * which hash to `inputHash`, evicting the least recently used entry once
+     * the cache is full
+     */
+    void store(uint64_t inputHash);
+
+    size_t getCapacity() const { return m_capacity; }
+    const ResultCacheStats& getStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        uint64_t inputHash { 0 };
+        std::vector<std::shared_ptr<void>> inputs;
+        std::vector<std::shared_ptr<void>> outputs;
+    };
+
+    std::vector<Attribute*> m_inputs;
+    std::vector<Attribute*> m_outputs;
+    std::vector<TypeDescriptor> m_inputTypes;
+    std::vector<TypeDescriptor> m_outputTypes;
+
+    size_t m_capacity { 0 };
+    bool matchesInputs(const Entry& entry) const;
+
+    std::vector<Entry> m_entries; // Most recently used first
+    ResultCacheStats m_stats;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_RESULTCACHE_HPP
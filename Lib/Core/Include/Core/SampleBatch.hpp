@@ -0,0 +1,186 @@
+#ifndef CF_CORE_SAMPLEBATCH_HPP
+#define CF_CORE_SAMPLEBATCH_HPP
+
+#include "Core/Attribute.hpp"
+#include "Core/ExecutionPlan.hpp"
+#include "Core/InputAttribute.hpp"
+#include "Core/Node.hpp"
+#include "Core/OutputAttribute.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace cf::core {
+
+class Scene;
+
+/**
+ * @brief Values of one attribute for every sample of a batch, stored
+ * contiguously
+ */
+class LaneArray {
+public:
+    LaneArray(TypeHandle typeHandle, size_t laneCount);
+    ~LaneArray();
+
+    LaneArray(LaneArray&& other) noexcept;
+    LaneArray& operator=(LaneArray&& other) noexcept;
+    LaneArray(const LaneArray&) = delete;
+    LaneArray& operator=(const LaneArray&) = delete;
+
+    TypeHandle getTypeHandle() const { return m_typeHandle; }
+    size_t getLaneCount() const { return m_laneCount; }
+
+    void* getData() { return m_data; }
+    void* getLane(size_t index) { return static_cast<std::byte*>(m_data) + index * m_stride; }
+
+private:
+    TypeHandle m_typeHandle { kInvalidTypeHandle };
+    size_t m_laneCount { 0 };
+    size_t m_stride { 0 };
+    void* m_data { nullptr };
+    TypeDescriptor::DestroyFunc m_destroy { nullptr };
+};
+
+/**
+ * @brief Evaluates a scene's graph over many samples at once. Every attribute
+ * is stored as a lane array holding one value per sample; nodes that provide
+ * Node::computeBatch process all samples of a lane array in a single call.
+ *
+ * The batch captures the scene's topology when it is created and must be
+ * recreated after nodes or connections change. Nodes without a batch compute
+ * are run once per sample with their attributes redirected to that sample's
+ * lanes on the calling thread, so the scene's own values are never touched.
+ *
+ * Nodes whose inputs hold the same value in every sample, and are fed only
+ * by such nodes, are constant: they are computed once, their result is
+ * shared by every sample, and they only run again after setInput changes an
+ * input upstream of them. Nodes must therefore be pure.
+ */
+class SampleBatch {
+public:
+    /**
+     * @brief Creates lanes for every attribute of the scene, each filled with
+     * the attribute's current value. Connected inputs share the lanes of the
+     * output that feeds them.
+     */
+    SampleBatch(Scene& scene, size_t sampleCount);
+
+    size_t getSampleCount() const { return m_sampleCount; }
+
+    /**
+     * @brief Lanes of the given attribute, one value per sample. Writing the
+     * lanes of an unconnected input sets that input for each sample; the
+     * input, and every node downstream of it, is no longer constant.
+     */
+    template <typename Type>
+    std::span<Type> getLanes(AttributeHandle handle)
+    {
+        const uint32_t laneIndex = findLanes(handle, TypeRegistry::getTypeHandle<Type>());
+        onLanesExposed(laneIndex);
+
+        return { static_cast<Type*>(m_lanes[laneIndex].getData()), m_sampleCount };
+    }
+
+    /**
+     * @brief Sets an unconnected input to the same value in every sample.
+     * Nodes constant before keep being constant, but are computed again.
+     */
+    template <typename Type>
+    void setInput(AttributeHandle handle, const Type& value)
+    {
+        const uint32_t laneIndex = findLanes(handle, TypeRegistry::getTypeHandle<Type>());
+        if (m_isLaneOutput[laneIndex]) {
+            throw std::runtime_error("SampleBatch::setInput - Attribute is connected: " + std::to_string(handle));
+        }
+
+        std::ranges::fill(std::span<Type>(static_cast<Type*>(m_lanes[laneIndex].getData()), m_sampleCount), value);
+        m_laneVersions[laneIndex] = ++m_version;
+        if (!m_isLaneUniform[laneIndex]) {
+            m_isLaneUniform[laneIndex] = true;
+            analyzeConstantSteps();
+        }
+    }
+
+    template <typename Type>
+    std::span<const Type> getInput(const InputAttribute<Type>& input)
+    {
+        const uint32_t laneIndex = findLanes(input.getHandle(), TypeRegistry::getTypeHandle<Type>());
+        return { static_cast<const Type*>(m_lanes[laneIndex].getData()), m_sampleCount };
+    }
+
+    template <typename Type>
+    std::span<Type> getOutput(const OutputAttribute<Type>& output)
+    {
+        const uint32_t laneIndex = findLanes(output.getHandle(), TypeRegistry::getTypeHandle<Type>());
+        return { static_cast<Type*>(m_lanes[laneIndex].getData()), m_sampleCount };
+    }
+
+    /**
+     * @brief Number of nodes whose inputs are the same in every sample
+     */
+    size_t getConstantNodeCount() const;
+
+    /**
+     * @brief Computes every node over all samples in topological order. The
+     * scene's attribute values are unchanged afterwards.
+     */
+    void evaluate();
+
+private:
+    // An attribute of a node without a batch compute, and the lanes it reads
+    // and writes for each sample
+    struct SampleBinding {
+        uint32_t slot { 0 }; // Slot index of the attribute handle
+        uint32_t lanes { 0 };
+    };
+
+    struct BatchStep {
+        Node* node { nullptr };
+        uint32_t firstBinding { 0 };
+        uint32_t bindingCount { 0 };
+
+        // Ranges of m_stepLanes: the lanes the node reads, then the ones it writes
+        uint32_t firstLane { 0 };
+        uint32_t inputLaneCount { 0 };
+        uint32_t outputLaneCount { 0 };
+
+        bool isConstant { false };
+        uint64_t computedVersion { 0 }; // m_version when last computed while constant, 0 if not
+    };
+
+    uint32_t findLanes(AttributeHandle handle, TypeHandle typeHandle) const;
+    void onLanesExposed(uint32_t laneIndex);
+    void analyzeConstantSteps();
+    bool isUpToDate(const BatchStep& step) const;
+    void computePerSample(const BatchStep& step, size_t sampleCount);
+    void broadcastFirstSample(uint32_t laneIndex);
+
+    size_t m_sampleCount { 0 };
+
+    std::vector<LaneArray> m_lanes;
+    std::unordered_map<AttributeHandle, uint32_t> m_laneIndex;
+
+    // Per lane: every sample holds the same value, the lane is written by a
+    // node, and m_version when its values last changed
+    std::vector<bool> m_isLaneUniform;
+    std::vector<bool> m_isLaneOutput;
+    std::vector<uint64_t> m_laneVersions;
+    std::vector<uint32_t> m_laneCopyFunctions;
+    uint64_t m_version { 0 };
+
+    std::vector<BatchStep> m_steps;
+    std::vector<uint32_t> m_stepLanes;
+    std::vector<SampleBinding> m_bindings;
+    std::vector<void*> m_sampleStorage; // Indexed by slot index, see AttributeStorageScope
+    std::vector<CopyFunc> m_copyFunctions;
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_SAMPLEBATCH_HPP
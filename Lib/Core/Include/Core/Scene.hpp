@@ -2,16 +2,24 @@
 #define CF_CORE_SCENE_HPP
 
 #include "Core/Attribute.hpp"
+#include "Core/AttributeStorage.hpp"
+#include "Core/EvaluationControl.hpp"
 #include "Core/EventBus.hpp"
 #include "Core/Events/AttributeEvent.hpp"
+#include "Core/ExecutionPlan.hpp"
 #include "Core/InputAttribute.hpp"
 #include "Core/Node.hpp"
 #include "Core/OutputAttribute.hpp"
+#include "Core/ResultCache.hpp"
+#include "Core/SlotMap.hpp"
+#include "Core/ThreadPool.hpp"
 #include "Core/TypeRegistry.hpp"
 
 #include <algorithm>
 #include <memory>
+#include <span>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <spdlog/spdlog.h>
 
@@ -24,13 +32,49 @@ struct Connection {
     AttributeHandle attributeTarget;
 };
 
+/**
+ * @brief Connections entering and leaving a single node or attribute
+ */
+struct ConnectionList {
+    std::vector<Connection> incoming;
+    std::vector<Connection> outgoing;
+};
+
+/**
+ * @brief What Scene::removeNodes took out of a scene, so that restoreNodes
+ * can put it back. The removed nodes and their attributes stay alive, with
+ * their current values, and their handles stay reserved, for as long as this
+ * or a copy of it is held.
+ */
+struct RemovedNodes {
+    struct Entry {
+        NodeHandle handle { kInvalidNodeHandle };
+        std::shared_ptr<Node> node;
+        std::vector<std::shared_ptr<Attribute>> attributes; // In descriptor order
+    };
+
+    std::vector<Entry> nodes;
+    std::vector<Connection> connections; // Every connection of a removed node
+    std::vector<std::pair<AttributeHandle, uint32_t>> requestedOutputs; // Request counts
+
+    // Hands the slots of the removed handles back to the scene once released
+    std::shared_ptr<void> slotReservation;
+
+    bool empty() const { return nodes.empty(); }
+};
+
+enum class EvaluationMode {
+    eSerial, // Dirty nodes are computed one after another on the calling thread
+    eParallel // Each dirty node is computed on a ThreadPool as soon as its upstream nodes are done
+};
+
 class Scene {
 public:
     Scene()
     {
         EventBus::SubscriptionId subId = EventBus::subscribe<AttributeEvent>([&](const AttributeEvent& event) {
             if (event.m_message == AttributeEvent::AttributeMessage::eAttributeChanged) {
-                evaluate();
+                onAttributeChanged(event.attributeHandle);
             }
         });
 
@@ -42,34 +86,64 @@ public:
         for (const auto& subId : m_subscriptions) {
             EventBus::unsubscribe(subId);
         }
+
+        // Nodes and attributes may be held past the scene, while the values
+        // in m_attributeStorage are freed with it. Once the scene's own
+        // references to the nodes are dropped, m_attributes holds the only
+        // reference to every attribute that does not outlive the scene, and
+        // only the others need a copy of their value.
+        m_plan.reset();
+        m_nodes = {};
+        m_nodeAttributes.clear();
+        for (const auto& [handle, attribute] : m_attributes) {
+            if (attribute.use_count() > 1) {
+                attribute->detachStorage();
+            }
+        }
     }
 
     template <NodeConcept NodeType>
     std::shared_ptr<NodeType> addNode(std::unique_ptr<NodeType> node)
     {
-        const auto& desc = TypeRegistry::getNodeDescriptor<NodeType>();
-
-        NodeHandle handle = generateNodeHandle();
-        m_nodes[handle] = std::move(node);
-        m_nodes[handle]->setName("Node " + std::to_string(handle));
-
-        for (const auto& attrDesc : desc.attributes) {
-            auto attribute = createAttribute(attrDesc);
-            if (attrDesc.setter) {
-                attrDesc.setter(static_cast<void*>(m_nodes[handle].get()), attribute);
-            }
+        std::shared_ptr<NodeType> added = std::move(node);
+        const NodeHandle handle = insertNode(added, added.get(), TypeRegistry::getNodeDescriptor<NodeType>());
 
+        for (const auto& attribute : getNodeAttributes(handle)) {
             spdlog::info("Created attribute '{}' with handle {} for node '{}'",
-                attrDesc.name, attribute->getHandle(), m_nodes[handle]->getName());
+                attribute->getAttributeDescriptor().name, attribute->getHandle(), added->getName());
+        }
 
-            nodeAttributes[attribute->getHandle()] = handle;
+        return added;
+    }
+
+    /**
+     * @brief Adds `count` default constructed nodes of the given type, e.g.
+     * when generating a scene. Storage for all of them is reserved up front,
+     * the descriptor is looked up once and a single summary is logged
+     * instead of one line per attribute.
+     *
+     * @return the handles of the new nodes, in creation order
+     */
+    template <NodeConcept NodeType>
+        requires std::default_initializable<NodeType>
+    std::vector<NodeHandle> addNodes(size_t count)
+    {
+        const NodeDescriptor& desc = TypeRegistry::getNodeDescriptor<NodeType>();
+        reserveNodes(count, desc.attributes.size());
+
+        std::vector<NodeHandle> handles;
+        handles.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto node = std::make_shared<NodeType>();
+            handles.push_back(insertNode(node, node.get(), desc));
         }
 
-        return std::static_pointer_cast<NodeType>(m_nodes[handle]);
+        spdlog::info("Added {} nodes of type '{}'", count, desc.typeName);
+        return handles;
     }
 
     template <typename Type>
-    void connect(std::shared_ptr<Node> formNode, OutputAttribute<Type>& fromAttr,
+    bool connect(std::shared_ptr<Node> formNode, OutputAttribute<Type>& fromAttr,
         std::shared_ptr<Node> toNode, InputAttribute<Type>& toAttr)
     {
 
@@ -79,75 +153,114 @@ public:
         NodeHandle fromNodeHandle = getNodeHandle(formNode);
         NodeHandle toNodeHandle = getNodeHandle(toNode);
 
-        connections.emplace_back(
+        return insertConnection(
             Connection { fromNodeHandle, fromHandleAttr, toNodeHandle, toHandleAttr });
     }
 
-    void addConnection(AttributeHandle fromAttr, AttributeHandle toAttr)
+    bool addConnection(AttributeHandle fromAttr, AttributeHandle toAttr)
     {
-        auto fromNodeIt = nodeAttributes.find(fromAttr);
-        auto toNodeIt = nodeAttributes.find(toAttr);
+        const NodeHandle fromNode = getAttributeNode(fromAttr);
+        const NodeHandle toNode = getAttributeNode(toAttr);
 
-        if (fromNodeIt == nodeAttributes.end() || toNodeIt == nodeAttributes.end()) {
+        if (fromNode == kInvalidNodeHandle || toNode == kInvalidNodeHandle) {
             spdlog::error("Scene::addConnection - Invalid attribute handle(s) provided");
-            return;
+            return false;
         }
 
-        connections.emplace_back(
-            Connection { fromNodeIt->second, fromAttr, toNodeIt->second, toAttr });
+        return insertConnection(
+            Connection { fromNode, fromAttr, toNode, toAttr });
     }
 
-    void removeConnection(AttributeHandle fromAttr, AttributeHandle toAttr)
+    void removeConnection(AttributeHandle fromAttr, AttributeHandle toAttr);
+
+    /**
+     * @brief Removes the nodes along with their attributes and connections.
+     * The cost is proportional to the nodes' attributes and connections, not
+     * to the size of the scene. Nodes fed by a removed node keep the last
+     * value they read from it and are marked dirty.
+     *
+     * A single NodeEvent is published for the whole call. Handles of the
+     * removed nodes and attributes stop resolving; stale or repeated handles
+     * are ignored.
+     *
+     * @return what was removed, for restoreNodes to undo the removal
+     */
+    RemovedNodes removeNodes(std::span<const NodeHandle> handles);
+    RemovedNodes removeNode(NodeHandle handle) { return removeNodes(std::span(&handle, 1)); }
+
+    /**
+     * @brief Puts nodes taken out by removeNodes back under their original
+     * handles, with the values their attributes held, and reconnects them.
+     * Their slots are not reused while `removed` is held, so nodes added
+     * since the removal do not get in the way.
+     *
+     * @return false, restoring nothing, if the nodes were already restored or
+     * were not removed from this scene
+     */
+    bool restoreNodes(const RemovedNodes& removed);
+
+    const SlotMap<std::shared_ptr<Node>>& getNodes() const { return m_nodes; }
+    const SlotMap<std::shared_ptr<Attribute>>& getAttributes() const { return m_attributes; }
+    const std::vector<Connection>& getConnections() const { return connections; }
+
+    const ConnectionList& getNodeConnections(NodeHandle handle) const;
+    const ConnectionList& getAttributeConnections(AttributeHandle handle) const;
+
+    std::shared_ptr<Node> getNode(NodeHandle handle) const
     {
-        std::erase_if(connections, [fromAttr, toAttr](const Connection& conn) {
-            return conn.attributeSource == fromAttr && conn.attributeTarget == toAttr;
-        });
+        const auto* node = m_nodes.find(handle);
+        return node ? *node : nullptr;
     }
 
-    const std::unordered_map<NodeHandle, std::shared_ptr<Node>>& getNodes() const { return m_nodes; }
-    const std::unordered_map<AttributeHandle, std::shared_ptr<Attribute>>& getAttributes() const { return attributes; }
-    const std::vector<Connection>& getConnections() const { return connections; }
-
     std::shared_ptr<Attribute> getAttribute(AttributeHandle handle) const
     {
-        auto it = attributes.find(handle);
-        if (it != attributes.end()) {
-            return it->second;
-        }
-        return nullptr;
+        const auto* attribute = m_attributes.find(handle);
+        return attribute ? *attribute : nullptr;
     }
 
-    std::vector<std::shared_ptr<Attribute>> getNodeAttributes(std::shared_ptr<Node> node) const
+    /**
+     * @return kInvalidNodeHandle if the handle is stale or not from this scene
+     */
+    NodeHandle getAttributeNode(AttributeHandle handle) const
     {
-        std::vector<std::shared_ptr<Attribute>> result;
-        NodeHandle nodeHandle = getNodeHandle(node);
-        for (const auto& [attrHandle, handleNode] : nodeAttributes) {
-            if (handleNode == nodeHandle) {
-                auto attrIt = attributes.find(attrHandle);
-                if (attrIt != attributes.end()) {
-                    result.push_back(attrIt->second);
-                }
-            }
+        return m_attributes.contains(handle) ? m_attributeNodes[getSlotIndex(handle)] : kInvalidNodeHandle;
+    }
+
+    /**
+     * @brief The node's attributes in descriptor order, empty if the node is
+     * not part of this scene. Valid until the node is removed.
+     */
+    std::span<const std::shared_ptr<Attribute>> getNodeAttributes(NodeHandle handle) const
+    {
+        if (!m_nodes.contains(handle)) {
+            return {};
         }
 
-        spdlog::info("Found {} attributes for node '{}'", result.size(), node->getName());
-        return result;
+        return m_nodeAttributes[getSlotIndex(handle)];
+    }
+
+    std::span<const std::shared_ptr<Attribute>> getNodeAttributes(std::shared_ptr<Node> node) const
+    {
+        return getNodeAttributes(getNodeHandle(node));
     }
 
+    /**
+     * @return kInvalidNodeHandle if the node is not part of this scene
+     */
     NodeHandle getNodeHandle(std::shared_ptr<Node> node) const
     {
-        for (const auto& [handle, n] : m_nodes) {
-            if (n == node) {
-                return handle;
-            }
+        if (!node) {
+            return kInvalidNodeHandle;
         }
-        return kInvalidNodeHandle;
+
+        const auto* found = m_nodes.find(node->getHandle());
+        return found && *found == node ? node->getHandle() : kInvalidNodeHandle;
     }
 
     AttributeHandle getAttributeHandle(const TypedAttribute<float>& input) const
     {
         const AttributeHandle attrHandle = input.getHandle();
-        if (attributes.find(attrHandle) != attributes.end()) {
+        if (m_attributes.contains(attrHandle)) {
             return attrHandle;
         } else {
             return kInvalidAttributeHandle;
@@ -156,108 +269,284 @@ public:
 
     std::vector<std::shared_ptr<Node>> topologicalSort()
     {
-        std::unordered_map<NodeHandle, size_t> inDegree;
-        for (const auto& [handle, node] : m_nodes) {
-            inDegree[handle] = 0;
-        }
-
-        for (const auto& conn : connections) {
-            inDegree[conn.nodeTarget]++;
-        }
-
         std::vector<std::shared_ptr<Node>> sortedNodes;
-        std::vector<NodeHandle> zeroInDegreeNodes;
-
-        // Find nodes with zero in-degree
-        for (const auto& [handle, node] : m_nodes) {
-            if (inDegree[handle] == 0) {
-                zeroInDegreeNodes.push_back(handle);
-            }
-        }
-
-        while (!zeroInDegreeNodes.empty()) {
-            NodeHandle currentNodeHandle = zeroInDegreeNodes.back();
-            zeroInDegreeNodes.pop_back();
-
-            sortedNodes.push_back(m_nodes[currentNodeHandle]);
-
-            for (const auto& conn : connections) {
-                // Iterate through connections and reduce in-degree
-                // of all nodes that are connected to the current node
-                if (conn.nodeSource == currentNodeHandle) {
-                    inDegree[conn.nodeTarget]--;
-                    if (inDegree[conn.nodeTarget] == 0) {
-                        zeroInDegreeNodes.push_back(conn.nodeTarget);
-                    }
-                }
-            }
+        for (NodeHandle handle : topologicalOrder()) {
+            sortedNodes.push_back(getNode(handle));
         }
 
         return sortedNodes;
     }
 
-    void evaluate()
+    /**
+     * @brief Nodes in evaluation order. The order is maintained incrementally
+     * as connections are added, so reading it does not sort the graph.
+     */
+    const std::vector<NodeHandle>& topologicalOrder() const
     {
-        if (m_isEvaluating)
-            return;
-        m_isEvaluating = true;
-
-        std::vector<std::shared_ptr<Node>> sortedNodes = topologicalSort();
-        for (const auto& node : sortedNodes) {
-            if (node) {
-                propagateConnectionsToNode(node);
-
-                Status status = node->compute();
-                if (status != Status::eOK) {
-                    spdlog::error("Node '{}' computation failed with status: {}", node->getName(), static_cast<int>(status));
-                }
-            }
-        }
-
-        m_isEvaluating = false;
+        compactTopologicalOrder();
+        return m_topologicalOrder;
     }
 
-    void propagateConnectionsToNode(std::shared_ptr<Node> node)
+    /**
+     * @brief Recomputes every dirty node in topological order and marks it
+     * clean. Nodes that are not downstream of an edit since the previous
+     * evaluation are skipped, as are, when demand-driven, nodes no requested
+     * output depends on. Inside a transaction, evaluation is deferred until
+     * the transaction commits.
+     */
+    EvaluationStatus evaluate();
+
+    /**
+     * @brief Same as evaluate, but checks the token and the time budget
+     * between node computes and stops early once either runs out. The nodes
+     * computed so far are marked clean and their changes published; the rest
+     * stay dirty, so the next evaluation resumes from there.
+     */
+    EvaluationStatus evaluate(const CancellationToken& token,
+        std::optional<std::chrono::steady_clock::duration> budget = std::nullopt);
+
+    /**
+     * @brief Recomputes only the dirty nodes the given attributes depend on,
+     * i.e. their own nodes and the dirty nodes upstream of them. Every other
+     * node is left dirty.
+     */
+    EvaluationStatus evaluateOutputs(const std::vector<AttributeHandle>& outputs);
+
+    /**
+     * @brief Whether evaluation is limited to the requested outputs. When
+     * enabled, nodes that no requested output depends on are not computed and
+     * stay dirty until one that does is requested.
+     */
+    void setDemandDriven(bool isDemandDriven) { m_isDemandDriven = isDemandDriven; }
+    bool isDemandDriven() const { return m_isDemandDriven; }
+
+    /**
+     * @brief Adds an attribute, e.g. one shown in the UI or exported, to the
+     * outputs demand-driven evaluation computes. Requests are counted; each
+     * must be matched by a releaseOutput.
+     */
+    void requestOutput(AttributeHandle handle);
+    void releaseOutput(AttributeHandle handle);
+    bool isOutputRequested(AttributeHandle handle) const { return m_requestedOutputs.contains(handle); }
+
+    /**
+     * @brief Starts grouping edits. Until the matching commitTransaction,
+     * attribute change notifications raised on this thread are held back and
+     * the scene is not evaluated. Transactions nest; only the outermost
+     * commit takes effect.
+     */
+    void beginTransaction();
+
+    /**
+     * @brief Publishes one notification per attribute changed since
+     * beginTransaction, then runs a single evaluation
+     *
+     * @return the values this scene's attributes held before their first
+     * write in the transaction, empty for a nested commit
+     */
+    std::vector<AttributeEdit> commitTransaction();
+
+    bool isInTransaction() const { return m_transactionDepth > 0; }
+
+    /**
+     * @brief Marks the node owning the given attribute, and everything
+     * downstream of it, as requiring recomputation.
+     *
+     * @return false if the attribute does not belong to this scene
+     */
+    bool markDirty(AttributeHandle attributeHandle);
+    void markNodeDirty(NodeHandle nodeHandle);
+
+    /**
+     * @brief Returns the compiled form of the graph, recompiling it first if
+     * nodes or connections changed since it was built
+     */
+    const ExecutionPlan& getExecutionPlan();
+
+    /**
+     * @brief Same plan as getExecutionPlan, shared so that it stays alive for
+     * holders such as an EvaluationContext after the scene recompiles
+     */
+    std::shared_ptr<const ExecutionPlan> getSharedExecutionPlan();
+
+    /**
+     * @brief Whether attribute changes and committed transactions evaluate
+     * the scene right away. When disabled they only mark nodes dirty, for
+     * callers that evaluate elsewhere, such as an AsyncEvaluator.
+     */
+    void setEvaluateOnChange(bool evaluateOnChange) { m_evaluateOnChange = evaluateOnChange; }
+    bool getEvaluateOnChange() const { return m_evaluateOnChange; }
+
+    /**
+     * @brief Caches the outputs of every node of the given type, current and
+     * future, for its last `capacity` distinct input values. A node whose
+     * inputs match a cached entry has its outputs restored instead of being
+     * computed. Only for pure node types; a capacity of 0 disables the cache.
+     * Caches are used by the scene's own evaluation only.
+     *
+     * @return false if an input type of the node type cannot be hashed or
+     * compared, in which case nothing is cached
+     */
+    bool enableResultCache(NodeDescriptorHandle nodeType, size_t capacity);
+
+    template <NodeConcept NodeType>
+    bool enableResultCache(size_t capacity)
     {
-        NodeHandle targetHandle = getNodeHandle(node);
-        for (const auto& conn : connections) {
-            if (conn.nodeTarget == targetHandle) {
-                auto fromAttr = attributes[conn.attributeSource];
-                auto toAttr = attributes[conn.attributeTarget];
-                if (fromAttr && toAttr) {
-                    toAttr->setValue(fromAttr);
-                }
-            }
-        }
+        return enableResultCache(TypeRegistry::getNodeDescriptorHandle<NodeType>(), capacity);
     }
 
+    ResultCache* findResultCache(NodeHandle handle) const;
+
+    /**
+     * @brief Hits and misses summed over every cached node
+     */
+    ResultCacheStats getResultCacheStats() const;
+
+    void setEvaluationMode(EvaluationMode mode) { m_evaluationMode = mode; }
+    EvaluationMode getEvaluationMode() const { return m_evaluationMode; }
+
+    /**
+     * @brief Pool used by EvaluationMode::eParallel. Defaults to
+     * ThreadPool::getInstance(); the pool must outlive the scene.
+     */
+    void setThreadPool(ThreadPool& pool) { m_threadPool = &pool; }
+
+    bool isDirty(NodeHandle nodeHandle) const { return m_dirtyNodes.contains(nodeHandle); }
+    size_t getDirtyNodeCount() const { return m_dirtyNodes.size(); }
+
 private:
-    NodeHandle generateNodeHandle() { return m_nextNodeHandle++; }
+    void onAttributeChanged(AttributeHandle attributeHandle);
+
+    // Limited to the nodes `outputs` depend on when given
+    EvaluationStatus evaluateDirty(const EvaluationStopCondition& stopCondition, const std::vector<AttributeHandle>* outputs = nullptr);
+    void collectDemandedSteps(const ExecutionPlan& plan, const std::vector<AttributeHandle>& outputs, std::vector<uint32_t>& steps) const;
+
+    // Both fill completedSteps with the steps that were computed. A step that
+    // throws is not completed; its exception is stored in failure and no
+    // further steps are started.
+    EvaluationStatus evaluateSerial(const ExecutionPlan& plan, const std::vector<uint32_t>& dirtySteps,
+        const EvaluationStopCondition& stopCondition, std::vector<uint32_t>& completedSteps, std::vector<AttributeHandle>& changes,
+        std::exception_ptr& failure);
+    EvaluationStatus evaluateParallel(const ExecutionPlan& plan, const std::vector<uint32_t>& dirtySteps,
+        const EvaluationStopCondition& stopCondition, std::vector<uint32_t>& completedSteps, std::vector<AttributeHandle>& changes,
+        std::exception_ptr& failure);
+    static void runStep(const ExecutionPlan& plan, const ExecutionStep& step, std::vector<AttributeHandle>& changes);
+
+    bool createResultCache(NodeHandle handle, size_t capacity);
+
+    // `object` is the node as its most derived type, for the attribute setters
+    NodeHandle insertNode(std::shared_ptr<Node> node, void* object, const NodeDescriptor& desc);
+    void reserveNodes(size_t count, size_t attributesPerNode);
+
+    bool insertConnection(const Connection& connection);
+    void eraseNode(NodeHandle handle, RemovedNodes& removed);
+    // Hands the slots eraseNode retained back once `removed` is dropped
+    void reserveSlots(RemovedNodes& removed);
+    void releaseSlots();
+
+    // Removed nodes leave kInvalidNodeHandle in m_topologicalOrder until this
+    // closes the gaps
+    void compactTopologicalOrder() const;
+    bool reorderForConnection(NodeHandle source, NodeHandle target);
+
+    template <typename Func>
+    void forEachSuccessor(NodeHandle nodeHandle, Func&& func) const
+    {
+        for (const auto& conn : getNodeConnections(nodeHandle).outgoing) {
+            func(conn.nodeTarget);
+        }
+    }
 
-    AttributeHandle generateAttributeHandle()
+    template <typename Func>
+    void forEachPredecessor(NodeHandle nodeHandle, Func&& func) const
     {
-        return nextAttributeHandle++;
+        for (const auto& conn : getNodeConnections(nodeHandle).incoming) {
+            func(conn.nodeSource);
+        }
     }
 
-    std::shared_ptr<Attribute> createAttribute(const AttributeDescriptor& desc)
+    struct ConnectionKeyHash {
+        size_t operator()(const std::pair<AttributeHandle, AttributeHandle>& key) const noexcept
+        {
+            return std::hash<AttributeHandle> {}(key.first) ^ (std::hash<AttributeHandle> {}(key.second) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    std::shared_ptr<Attribute> createAttribute(const AttributeDescriptor& desc, NodeHandle nodeHandle)
     {
-        AttributeHandle handle = generateAttributeHandle();
-        auto attribute = std::make_shared<Attribute>(desc, handle);
-        attributes[handle] = attribute;
+        // The handle is only known once the slot is taken, so the attribute is
+        // created in place afterwards
+        const AttributeHandle handle = m_attributes.insert(nullptr);
+        auto attribute = std::make_shared<Attribute>(desc, handle, m_attributeStorage.allocate(desc.typeHandle));
+        *m_attributes.find(handle) = attribute;
+
+        const uint32_t index = getSlotIndex(handle);
+        if (index >= m_attributeNodes.size()) {
+            m_attributeNodes.resize(index + 1, kInvalidNodeHandle);
+        }
+        m_attributeNodes[index] = nodeHandle;
+        m_nodeAttributes[getSlotIndex(nodeHandle)].push_back(attribute);
+
         return attribute;
     }
 
     bool m_isEvaluating { false };
+    bool m_evaluateOnChange { true };
+    EvaluationMode m_evaluationMode { EvaluationMode::eSerial };
+    ThreadPool* m_threadPool { nullptr };
+
+    std::shared_ptr<const ExecutionPlan> m_plan;
+    bool m_isPlanValid { false };
+    std::vector<std::atomic<uint32_t>> m_pendingInputs; // Per plan step, scratch for parallel evaluation
+    std::vector<bool> m_isStepScheduled; // Per plan step, scratch for parallel evaluation
     uint64_t m_m_evaluationCount { 0 };
 
-    NodeHandle m_nextNodeHandle { 1 };
-    AttributeHandle nextAttributeHandle { 1 };
+    // Declared before the attributes so their values outlive them. Attributes
+    // still referenced outside the scene, directly or through their node,
+    // take a copy of their value when the scene is destroyed.
+    AttributeStorage m_attributeStorage;
+
+    SlotMap<std::shared_ptr<Node>> m_nodes;
+    SlotMap<std::shared_ptr<Attribute>> m_attributes;
+    std::vector<NodeHandle> m_attributeNodes; // Owning node per attribute slot index
+    std::vector<std::vector<std::shared_ptr<Attribute>>> m_nodeAttributes; // Per node slot index, in descriptor order
+
+    // Slots of removed handles whose RemovedNodes was dropped, freed on the
+    // next insertion. Shared, as a RemovedNodes may outlive the scene.
+    struct ReleasedSlots {
+        std::vector<NodeHandle> nodes;
+        std::vector<AttributeHandle> attributes;
+    };
+    std::shared_ptr<ReleasedSlots> m_releasedSlots { std::make_shared<ReleasedSlots>() };
 
-    std::unordered_map<NodeHandle, std::shared_ptr<Node>> m_nodes;
-    std::unordered_map<AttributeHandle, std::shared_ptr<Attribute>> attributes;
-    std::unordered_map<AttributeHandle, NodeHandle> nodeAttributes;
     std::vector<Connection> connections;
 
+    // Adjacency indexes over `connections`, plus each connection's position in it
+    std::unordered_map<NodeHandle, ConnectionList> m_nodeConnections;
+    std::unordered_map<AttributeHandle, ConnectionList> m_attributeConnections;
+    std::unordered_map<std::pair<AttributeHandle, AttributeHandle>, size_t, ConnectionKeyHash> m_connectionIndex;
+
+    // Every connection points from a lower to a higher position in this order.
+    // Compacting keeps the relative order, so it is done lazily on read.
+    mutable std::vector<NodeHandle> m_topologicalOrder;
+    mutable std::unordered_map<NodeHandle, size_t> m_topologicalIndex;
+    mutable size_t m_topologicalGaps { 0 };
+
+    // Closed under "downstream of": if a node is dirty, so is every node it feeds
+    std::unordered_set<NodeHandle> m_dirtyNodes;
+
+    bool m_isDemandDriven { false };
+    std::unordered_map<AttributeHandle, uint32_t> m_requestedOutputs; // Request count per attribute
+
+    std::unordered_map<NodeDescriptorHandle, size_t> m_resultCacheCapacities;
+    std::unordered_map<NodeHandle, std::unique_ptr<ResultCache>> m_resultCaches;
+
+    // Open while m_transactionDepth > 0
+    uint32_t m_transactionDepth { 0 };
+    std::vector<AttributeHandle> m_transactionChanges;
+    std::unique_ptr<AttributeChangeCapture> m_transactionCapture;
+    std::unique_ptr<AttributeEditRecorder> m_transactionRecorder;
+
     std::vector<EventBus::SubscriptionId> m_subscriptions;
 };
 
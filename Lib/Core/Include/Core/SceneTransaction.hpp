@@ -0,0 +1,37 @@
+#ifndef CF_CORE_SCENETRANSACTION_HPP
+#define CF_CORE_SCENETRANSACTION_HPP
+
+#include "Core/Scene.hpp"
+#include "Core/UndoStack.hpp"
+
+#include <memory>
+
+namespace cf::core {
+
+/**
+ * @brief Scoped Scene::beginTransaction / commitTransaction pair. Attribute
+ * edits made while it is open are evaluated once when it commits, either
+ * explicitly or when it goes out of scope. When given an UndoStack, the
+ * edits are pushed onto it as a single command.
+ */
+class SceneTransaction {
+public:
+    explicit SceneTransaction(Scene& scene);
+    SceneTransaction(std::shared_ptr<Scene> scene, UndoStack& undoStack);
+    ~SceneTransaction();
+
+    SceneTransaction(const SceneTransaction&) = delete;
+    SceneTransaction& operator=(const SceneTransaction&) = delete;
+
+    void commit();
+
+private:
+    Scene& m_scene;
+    std::shared_ptr<Scene> m_sharedScene; // Kept for the undo command
+    UndoStack* m_undoStack { nullptr };
+    bool m_isOpen { true };
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_SCENETRANSACTION_HPP
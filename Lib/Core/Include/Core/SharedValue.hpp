@@ -0,0 +1,85 @@
+#ifndef CF_CORE_SHAREDVALUE_HPP
+#define CF_CORE_SHAREDVALUE_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace cf::core {
+
+/**
+ * @brief Copy-on-write holder for large attribute values. The value lives in
+ * a reference counted block that is only read while shared: copies share the
+ * block, and edit clones it only while another copy still refers to it.
+ *
+ * Registered as an attribute type, e.g. SharedFloatArray, it
+ * lets undo snapshots, evaluation contexts and result caches keep a value
+ * without duplicating its payload, as all of them copy values through
+ * TypeDescriptor::copy. A default constructed value holds no block and reads
+ * as a default constructed Type.
+ */
+template <typename Type>
+class SharedValue {
+public:
+    SharedValue() = default;
+
+    explicit SharedValue(Type value)
+        : m_block(std::make_shared<Type>(std::move(value)))
+    {
+    }
+
+    const Type& get() const { return m_block ? *m_block : getDefault(); }
+    const Type& operator*() const { return get(); }
+    const Type* operator->() const { return &get(); }
+
+    /**
+     * @brief Mutable access to the value, cloning the block first if it is
+     * shared. The reference is invalidated by the next copy of this value.
+     */
+    Type& edit()
+    {
+        if (!m_block) {
+            m_block = std::make_shared<Type>();
+        } else if (m_block.use_count() > 1) {
+            m_block = std::make_shared<Type>(*m_block);
+        }
+
+        // The block is only reachable through this value now
+        return *m_block;
+    }
+
+    bool isSharedWith(const SharedValue& other) const { return m_block && m_block == other.m_block; }
+    long getUseCount() const { return m_block.use_count(); }
+
+    // Constrained so that TypeRegistry only sees equality when Type has it
+    friend bool operator==(const SharedValue& lhs, const SharedValue& rhs)
+        requires std::equality_comparable<Type>
+    {
+        return lhs.m_block == rhs.m_block || lhs.get() == rhs.get();
+    }
+
+private:
+    static const Type& getDefault()
+    {
+        static const Type value {};
+        return value;
+    }
+
+    std::shared_ptr<Type> m_block; // Only handed out as const, except by edit
+};
+
+} // namespace cf::core
+
+// Hashes the value rather than the block, so equal values share cache entries
+template <typename Type>
+    requires requires(const Type& value) { std::hash<Type> {}(value); }
+struct std::hash<cf::core::SharedValue<Type>> {
+    size_t operator()(const cf::core::SharedValue<Type>& value) const
+    {
+        return std::hash<Type> {}(value.get());
+    }
+};
+
+#endif // CF_CORE_SHAREDVALUE_HPP
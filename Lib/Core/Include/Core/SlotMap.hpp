@@ -0,0 +1,239 @@
+#ifndef CF_CORE_SLOTMAP_HPP
+#define CF_CORE_SLOTMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace cf::core {
+
+/**
+ * @brief Handles into a SlotMap pack the slot index in the low 32 bits and
+ * the slot's generation in the high 32 bits. Generations start at 1, so no
+ * valid handle is 0.
+ */
+using SlotHandle = uint64_t;
+
+constexpr uint32_t getSlotIndex(SlotHandle handle) { return static_cast<uint32_t>(handle); }
+constexpr uint32_t getSlotGeneration(SlotHandle handle) { return static_cast<uint32_t>(handle >> 32); }
+constexpr SlotHandle makeSlotHandle(uint32_t index, uint32_t generation) { return (static_cast<SlotHandle>(generation) << 32) | index; }
+
+/**
+ * @brief Values addressed by generational handles. A handle resolves with an
+ * index and a generation compare; erasing a value bumps its slot's
+ * generation, so handles to it stop resolving even after the slot is reused.
+ *
+ * Values live in a single vector and freed slots are reused before it grows,
+ * so repeated insertion and removal does not fragment memory. Iteration
+ * visits live values in slot order.
+ */
+template <typename Value>
+class SlotMap {
+public:
+    class ConstIterator {
+    public:
+        ConstIterator(const SlotMap& map, uint32_t index)
+            : m_map(&map)
+            , m_index(index)
+        {
+            skipFree();
+        }
+
+        std::pair<SlotHandle, const Value&> operator*() const
+        {
+            const Slot& slot = m_map->m_slots[m_index];
+            return { makeSlotHandle(m_index, slot.generation), *slot.value };
+        }
+
+        ConstIterator& operator++()
+        {
+            ++m_index;
+            skipFree();
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const { return m_index == other.m_index; }
+
+    private:
+        void skipFree()
+        {
+            while (m_index < m_map->m_slots.size() && !m_map->m_slots[m_index].value) {
+                ++m_index;
+            }
+        }
+
+        const SlotMap* m_map;
+        uint32_t m_index;
+    };
+
+    SlotHandle insert(Value value)
+    {
+        uint32_t index = 0;
+        if (!m_freeSlots.empty()) {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        Slot& slot = m_slots[index];
+        slot.value.emplace(std::move(value));
+        ++m_size;
+
+        return makeSlotHandle(index, slot.generation);
+    }
+
+    /**
+     * @return false if the handle is stale or was never valid
+     */
+    bool erase(SlotHandle handle)
+    {
+        Slot* slot = findSlot(handle);
+        if (!slot) {
+            return false;
+        }
+
+        slot->value.reset();
+        slot->generation = nextGeneration(slot->generation);
+        if (slot->retainCount == 0) {
+            pushFreeSlot(getSlotIndex(handle));
+        }
+        --m_size;
+
+        return true;
+    }
+
+    /**
+     * @brief Keeps the handle's slot from being reused once its value is
+     * erased, until a matching releaseSlot, so that restore cannot fail for
+     * lack of it. Retains are counted.
+     */
+    void retainSlot(SlotHandle handle)
+    {
+        const uint32_t index = getSlotIndex(handle);
+        if (index < m_slots.size()) {
+            ++m_slots[index].retainCount;
+        }
+    }
+
+    void releaseSlot(SlotHandle handle)
+    {
+        const uint32_t index = getSlotIndex(handle);
+        if (index >= m_slots.size() || m_slots[index].retainCount == 0) {
+            return;
+        }
+
+        Slot& slot = m_slots[index];
+        if (--slot.retainCount == 0 && !slot.value) {
+            pushFreeSlot(index);
+        }
+    }
+
+    /**
+     * @brief Whether restore would succeed: the handle's value was erased and
+     * its slot has not been reused since
+     */
+    bool canRestore(SlotHandle handle) const
+    {
+        const uint32_t index = getSlotIndex(handle);
+        if (index >= m_slots.size()) {
+            return false;
+        }
+
+        const Slot& slot = m_slots[index];
+        return !slot.value && slot.generation == nextGeneration(getSlotGeneration(handle));
+    }
+
+    /**
+     * @brief Puts a value back under the handle it was erased with, e.g. to
+     * undo a removal, so that handles held elsewhere resolve again
+     *
+     * @return false if canRestore does not hold
+     */
+    bool restore(SlotHandle handle, Value value)
+    {
+        if (!canRestore(handle)) {
+            return false;
+        }
+
+        // A retained slot was never put on the free list
+        Slot& slot = m_slots[getSlotIndex(handle)];
+        if (slot.retainCount == 0) {
+            const uint32_t last = m_freeSlots.back();
+            m_freeSlots[slot.freePosition] = last;
+            m_slots[last].freePosition = slot.freePosition;
+            m_freeSlots.pop_back();
+        }
+
+        slot.value.emplace(std::move(value));
+        slot.generation = getSlotGeneration(handle);
+        ++m_size;
+
+        return true;
+    }
+
+    Value* find(SlotHandle handle)
+    {
+        Slot* slot = findSlot(handle);
+        return slot ? &*slot->value : nullptr;
+    }
+
+    const Value* find(SlotHandle handle) const
+    {
+        return const_cast<SlotMap*>(this)->find(handle);
+    }
+
+    bool contains(SlotHandle handle) const { return find(handle) != nullptr; }
+
+    void reserve(size_t capacity) { m_slots.reserve(capacity); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Upper bound of the slot indices in use, for containers indexed
+     * by getSlotIndex
+     */
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+
+    ConstIterator begin() const { return ConstIterator(*this, 0); }
+    ConstIterator end() const { return ConstIterator(*this, getSlotCount()); }
+
+private:
+    struct Slot {
+        std::optional<Value> value;
+        uint32_t generation { 1 };
+        uint32_t freePosition { 0 }; // In m_freeSlots, while free
+        uint32_t retainCount { 0 };
+    };
+
+    void pushFreeSlot(uint32_t index)
+    {
+        m_slots[index].freePosition = static_cast<uint32_t>(m_freeSlots.size());
+        m_freeSlots.push_back(index);
+    }
+
+    static uint32_t nextGeneration(uint32_t generation) { return generation == UINT32_MAX ? 1 : generation + 1; }
+
+    Slot* findSlot(SlotHandle handle)
+    {
+        const uint32_t index = getSlotIndex(handle);
+        if (index >= m_slots.size()) {
+            return nullptr;
+        }
+
+        Slot& slot = m_slots[index];
+        return slot.value && slot.generation == getSlotGeneration(handle) ? &slot : nullptr;
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    size_t m_size { 0 };
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_SLOTMAP_HPP
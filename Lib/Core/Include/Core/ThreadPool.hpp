@@ -0,0 +1,72 @@
+#ifndef CF_CORE_THREADPOOL_HPP
+#define CF_CORE_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cf::core {
+
+/**
+ * @brief Work-stealing thread pool. Every worker owns a task deque: it pushes
+ * and pops its own work at the back and, when empty, steals from the front of
+ * the other workers' deques. Tasks submitted from outside the pool are
+ * distributed round-robin.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& getInstance()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    void submit(Task task);
+
+    /**
+     * @brief Runs one queued task on the calling thread, if there is any.
+     * Threads waiting for pool work should call this instead of blocking, so
+     * waiting from inside a task cannot starve the pool.
+     *
+     * @return true if a task was run
+     */
+    bool runPendingTask();
+
+    size_t getThreadCount() const { return m_threads.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool tryPop(size_t index, Task& task);
+    bool trySteal(size_t thiefIndex, Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<size_t> m_pendingTasks { 0 };
+    std::atomic<size_t> m_nextQueue { 0 };
+    std::atomic<bool> m_stopping { false };
+};
+
+} // namespace cf::core
+
+#endif // CF_CORE_THREADPOOL_HPP
@@ -28,15 +28,44 @@ static constexpr NodeDescriptorHandle kInvalidNodeDescriptorHandle = 0;
 using EventDescriptorHandle = std::uint64_t;
 static constexpr EventDescriptorHandle kInvalidEventDescriptorHandle = 0;
 
+/**
+ * @brief Type-erased operations of one registered type, as plain function
+ * pointers generated per type, so each call is a single indirect call
+ */
 struct TypeDescriptor {
+    using CreateFunc = void* (*)();
+    using ConstructAtFunc = void (*)(void*);
+    using CopyFunc = void (*)(void*, const void*);
+    using DestroyFunc = void (*)(void*);
+    using CreateArrayFunc = void* (*)(size_t);
+    using ToStringFunc = std::string (*)(const void*);
+    using HashFunc = size_t (*)(const void*);
+    using EqualFunc = bool (*)(const void*, const void*);
+
     std::string_view name;
-    size_t size;
+    size_t size { 0 };
+    size_t alignment { 0 };
+
+    CreateFunc create { nullptr };
+    CopyFunc copy { nullptr };
+    DestroyFunc destroy { nullptr };
+
+    // In-place counterparts of create and destroy, for storage of the type's
+    // size and alignment owned by the caller
+    ConstructAtFunc constructAt { nullptr };
+    DestroyFunc destroyAt { nullptr };
+
+    // Contiguous storage for `count` default constructed values
+    CreateArrayFunc createArray { nullptr };
+    DestroyFunc destroyArray { nullptr };
+
+    ToStringFunc toString { nullptr };
 
-    std::function<void*(void)> create;
-    std::function<void(void*, const void*)> copy;
-    std::function<void(void*)> destroy;
+    // Null for types without a std::hash specialization
+    HashFunc hash { nullptr };
 
-    std::function<std::string(const void*)> toString;
+    // Null for types without operator==
+    EqualFunc equal { nullptr };
 };
 
 enum class AttributeRole {
@@ -5,7 +5,10 @@
 #include "Core/DataTypes.hpp"
 #include "Core/TypeDescriptors.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <new>
 #include <source_location>
 #include <stdexcept>
 #include <unordered_map>
@@ -61,6 +64,30 @@ constexpr std::string_view getCoreDataType()
         return "cf::core::Double";
     } else if constexpr (std::same_as<Type, String>) {
         return "cf::core::String";
+    } else if constexpr (std::same_as<Type, FloatArray>) {
+        return "cf::core::FloatArray";
+    } else if constexpr (std::same_as<Type, DoubleArray>) {
+        return "cf::core::DoubleArray";
+    } else if constexpr (std::same_as<Type, Int32Array>) {
+        return "cf::core::Int32Array";
+    } else if constexpr (std::same_as<Type, SharedFloatArray>) {
+        return "cf::core::SharedFloatArray";
+    } else if constexpr (std::same_as<Type, SharedDoubleArray>) {
+        return "cf::core::SharedDoubleArray";
+    } else if constexpr (std::same_as<Type, SharedInt32Array>) {
+        return "cf::core::SharedInt32Array";
+    } else if constexpr (std::same_as<Type, Vec2>) {
+        return "cf::core::Vec2";
+    } else if constexpr (std::same_as<Type, Vec3>) {
+        return "cf::core::Vec3";
+    } else if constexpr (std::same_as<Type, Vec4>) {
+        return "cf::core::Vec4";
+    } else if constexpr (std::same_as<Type, Quat>) {
+        return "cf::core::Quat";
+    } else if constexpr (std::same_as<Type, Mat3>) {
+        return "cf::core::Mat3";
+    } else if constexpr (std::same_as<Type, Mat4>) {
+        return "cf::core::Mat4";
     } else {
         return "UnknownCoreType";
     }
@@ -97,13 +124,29 @@ template <typename Type>
 constexpr std::string_view getTypeName()
 {
     // Check for core data types first
-    if constexpr (IsCoreFundamentalType<Type>) {
+    if constexpr (IsCoreFundamentalType<Type> || IsCoreArrayType<Type> || IsCoreSharedArrayType<Type> || IsCoreMathType<Type>) {
         return getCoreDataType<Type>();
     } else {
         return getCustomTypeName<Type>();
     }
 }
 
+// Coefficients of a vector or matrix in row-major order, e.g. "(1, 0, 0)"
+template <typename Derived>
+std::string coefficientsToString(const Eigen::DenseBase<Derived>& value)
+{
+    std::string result = "(";
+    for (Eigen::Index row = 0; row < value.rows(); ++row) {
+        for (Eigen::Index col = 0; col < value.cols(); ++col) {
+            if (row > 0 || col > 0) {
+                result += ", ";
+            }
+            result += std::to_string(value(row, col));
+        }
+    }
+    return result + ")";
+}
+
 class TypeRegistry {
 public:
     static TypeRegistry& getInstance()
@@ -152,13 +195,13 @@ public:
     }
 
     template <typename Type>
-    static TypeDescriptor getTypeDescriptor()
+    static const TypeDescriptor& getTypeDescriptor()
     {
         return getInstance().getTypeDescriptorImpl<Type>();
     }
 
     template <typename Type>
-    TypeDescriptor getTypeDescriptorImpl() const
+    const TypeDescriptor& getTypeDescriptorImpl() const
     {
         TypeHandle handle = getTypeHandle<Type>();
         auto it = typeMap.find(handle);
@@ -169,12 +212,16 @@ public:
         throw std::runtime_error("Type not registered: " + std::string(typeid(Type).name()));
     }
 
-    static TypeDescriptor getTypeDescriptor(TypeHandle handle)
+    /**
+     * @brief Descriptor of a registered type. The reference stays valid
+     * until the registry is cleared.
+     */
+    static const TypeDescriptor& getTypeDescriptor(TypeHandle handle)
     {
         return getInstance().getTypeDescriptorImpl(handle);
     }
 
-    TypeDescriptor getTypeDescriptorImpl(TypeHandle handle) const
+    const TypeDescriptor& getTypeDescriptorImpl(TypeHandle handle) const
     {
         auto it = typeMap.find(handle);
         if (it != typeMap.end()) {
@@ -202,27 +249,57 @@ public:
         return handle;
     }
 
+    // Captureless lambdas, so each one converts to a plain function pointer
     template <typename Type>
     TypeDescriptor makeTypeDescriptor()
     {
         TypeDescriptor desc;
         // desc.name = TypeInfo<Type>::name();
         desc.size = sizeof(Type);
+        desc.alignment = alignof(Type);
 
+        // new uses the aligned allocation functions for over-aligned types,
+        // so the Eigen types are safe to allocate here
         desc.create = []() -> void* {
-            return new Type();
+            if constexpr (IsCoreMathType<Type>) {
+                return new Type(makeDefaultValue<Type>());
+            } else {
+                return new Type();
+            }
         };
 
+        // Both sides are live objects made by create, so this is an assignment
         desc.copy = [](void* dst, const void* src) {
-            new (dst) Type(*static_cast<const Type*>(src));
+            *static_cast<Type*>(dst) = *static_cast<const Type*>(src);
         };
 
+        // Values are heap allocated by create, whatever their type
         desc.destroy = [](void* ptr) {
-            if constexpr (std::is_trivially_destructible_v<Type>) {
-                delete static_cast<Type*>(ptr);
+            delete static_cast<Type*>(ptr);
+        };
+
+        desc.constructAt = [](void* ptr) {
+            if constexpr (IsCoreMathType<Type>) {
+                ::new (ptr) Type(makeDefaultValue<Type>());
             } else {
-                static_cast<Type*>(ptr)->~Type();
+                ::new (ptr) Type();
+            }
+        };
+
+        desc.destroyAt = [](void* ptr) {
+            std::destroy_at(static_cast<Type*>(ptr));
+        };
+
+        desc.createArray = [](size_t count) -> void* {
+            Type* values = new Type[count]();
+            if constexpr (IsCoreMathType<Type>) {
+                std::fill_n(values, count, makeDefaultValue<Type>());
             }
+            return values;
+        };
+
+        desc.destroyArray = [](void* ptr) {
+            delete[] static_cast<Type*>(ptr);
         };
 
         desc.toString = [](const void* ptr) -> std::string {
@@ -231,25 +308,45 @@ public:
                 return std::to_string(value);
             } else if constexpr (std::is_same_v<Type, std::string>) {
                 return value;
+            } else if constexpr (std::same_as<Type, Quat>) {
+                return coefficientsToString(value.coeffs());
+            } else if constexpr (IsCoreMathType<Type>) {
+                return coefficientsToString(value);
             } else {
                 return "unsupported";
             }
         };
 
+        if constexpr (requires(const Type& value) { std::hash<Type> {}(value); }) {
+            desc.hash = [](const void* ptr) -> size_t {
+                return std::hash<Type> {}(*static_cast<const Type*>(ptr));
+            };
+        }
+
+        if constexpr (requires(const Type& lhs, const Type& rhs) { { lhs == rhs } -> std::convertible_to<bool>; }) {
+            desc.equal = [](const void* lhs, const void* rhs) -> bool {
+                return *static_cast<const Type*>(lhs) == *static_cast<const Type*>(rhs);
+            };
+        }
+
         return desc;
     }
 
     /*-------------------------*/
     /*--- Node Registration ---*/
     /*-------------------------*/
+    /**
+     * @brief Descriptor of a registered node type. The reference stays valid
+     * until the registry is cleared.
+     */
     template <typename Type>
-    static NodeDescriptor getNodeDescriptor()
+    static const NodeDescriptor& getNodeDescriptor()
     {
         return getInstance().getNodeDescriptorImpl<Type>();
     }
 
     template <typename Type>
-    NodeDescriptor getNodeDescriptorImpl() const
+    const NodeDescriptor& getNodeDescriptorImpl() const
     {
         NodeDescriptorHandle handle = getNodeDescriptorHandle<Type>();
         auto it = nodeMap.find(handle);
@@ -261,12 +358,12 @@ public:
     }
 
     // TODO: Make TypeHandle a strong typedef to avoid confusion
-    static NodeDescriptor getNodeDescriptor(NodeDescriptorHandle handle)
+    static const NodeDescriptor& getNodeDescriptor(NodeDescriptorHandle handle)
     {
         return getInstance().getNodeDescriptorImpl(handle);
     }
 
-    NodeDescriptor getNodeDescriptorImpl(NodeDescriptorHandle handle) const
+    const NodeDescriptor& getNodeDescriptorImpl(NodeDescriptorHandle handle) const
     {
         auto it = nodeMap.find(handle);
         if (it != nodeMap.end()) {
@@ -304,12 +401,16 @@ public:
     /*--- Attribute Registration ----*/
     /*-------------------------------*/
 
-    static AttributeDescriptor getAttributeDescriptor(AttributeDescriptorHandle handle)
+    /**
+     * @brief Descriptor of a registered attribute. The reference stays valid
+     * until the registry is cleared.
+     */
+    static const AttributeDescriptor& getAttributeDescriptor(AttributeDescriptorHandle handle)
     {
         return getInstance().getAttributeDescriptorImpl(handle);
     }
 
-    AttributeDescriptor getAttributeDescriptorImpl(AttributeDescriptorHandle handle) const
+    const AttributeDescriptor& getAttributeDescriptorImpl(AttributeDescriptorHandle handle) const
     {
         auto it = attributeMap.find(handle);
         if (it != attributeMap.end()) {
@@ -319,6 +420,13 @@ public:
         throw std::runtime_error("Attribute not registered with handle: " + std::to_string(handle));
     }
 
+    static const AttributeDescriptor* findAttributeDescriptor(AttributeDescriptorHandle handle)
+    {
+        auto& attributes = getInstance().attributeMap;
+        auto it = attributes.find(handle);
+        return it != attributes.end() ? &it->second : nullptr;
+    }
+
     static void registerAttributeDescriptor(AttributeDescriptor& desc)
     {
         getInstance().registerAttributeDescriptorImpl(desc);
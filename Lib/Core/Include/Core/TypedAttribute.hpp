@@ -19,7 +19,7 @@ public:
             throw std::runtime_error("Null attribute pointer in TypedAttribute ");
         }
 
-        if (ptrToAttribute->getAttributeDescriptor().typeHandle != TypeRegistry::getTypeHandle<DataType>()) {
+        if (ptrToAttribute->getTypeHandle() != TypeRegistry::getTypeHandle<DataType>()) {
             throw std::runtime_error("Data type mismatch in TypedAttribute ");
         }
     }
@@ -50,6 +50,9 @@ protected:
     void setValue(const DataType& value) { ptrToAttribute->setValue<DataType>(value); }
     DataType getValue() const { return ptrToAttribute->getValue<DataType>(); }
 
+    // The type was checked on construction, so large values can be read in place
+    const DataType& getValueRef() const { return *static_cast<const DataType*>(ptrToAttribute->getValueData()); }
+
 private:
     std::shared_ptr<Attribute> ptrToAttribute;
 };
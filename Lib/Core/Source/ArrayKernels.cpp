@@ -0,0 +1,376 @@
+#include "ArrayKernels.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CF_CORE_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles intrinsics of any instruction set without a target attribute
+#if defined(CF_CORE_SIMD_X86) && !defined(_MSC_VER)
+#define CF_CORE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CF_CORE_TARGET_AVX2
+#endif
+
+namespace cf::core {
+
+namespace {
+
+    template <typename Type>
+    using ArrayKernel = void (*)(const Type*, const Type*, Type*, size_t);
+
+    template <ArrayOp Op, typename Type>
+    Type applyScalar(Type lhs, Type rhs)
+    {
+        // Integers wrap through unsigned arithmetic, as the vector kernels do
+        if constexpr (std::is_signed_v<Type> && std::is_integral_v<Type> && Op != ArrayOp::eDivide) {
+            using Unsigned = std::make_unsigned_t<Type>;
+            return static_cast<Type>(applyScalar<Op>(static_cast<Unsigned>(lhs), static_cast<Unsigned>(rhs)));
+        } else if constexpr (Op == ArrayOp::eAdd) {
+            return lhs + rhs;
+        } else if constexpr (Op == ArrayOp::eSubtract) {
+            return lhs - rhs;
+        } else if constexpr (Op == ArrayOp::eMultiply) {
+            return lhs * rhs;
+        } else {
+            return lhs / rhs;
+        }
+    }
+
+    template <ArrayOp Op, typename Type>
+    void computeScalar(const Type* lhs, const Type* rhs, Type* out, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = applyScalar<Op>(lhs[i], rhs[i]);
+        }
+    }
+
+#ifdef CF_CORE_SIMD_X86
+
+    // One register's worth of elements per instruction set and type. An op a
+    // set has no instruction for is left to the scalar kernel.
+    template <typename Type>
+    struct Sse2;
+
+    template <>
+    struct Sse2<Float> {
+        using Register = __m128;
+        static constexpr size_t kWidth = 4;
+
+        template <ArrayOp Op>
+        static constexpr bool kSupports = true;
+
+        static Register load(const Float* ptr) { return _mm_loadu_ps(ptr); }
+        static void store(Float* ptr, Register value) { _mm_storeu_ps(ptr, value); }
+
+        template <ArrayOp Op>
+        static Register apply(Register lhs, Register rhs)
+        {
+            if constexpr (Op == ArrayOp::eAdd) {
+                return _mm_add_ps(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eSubtract) {
+                return _mm_sub_ps(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eMultiply) {
+                return _mm_mul_ps(lhs, rhs);
+            } else {
+                return _mm_div_ps(lhs, rhs);
+            }
+        }
+    };
+
+    template <>
+    struct Sse2<Double> {
+        using Register = __m128d;
+        static constexpr size_t kWidth = 2;
+
+        template <ArrayOp Op>
+        static constexpr bool kSupports = true;
+
+        static Register load(const Double* ptr) { return _mm_loadu_pd(ptr); }
+        static void store(Double* ptr, Register value) { _mm_storeu_pd(ptr, value); }
+
+        template <ArrayOp Op>
+        static Register apply(Register lhs, Register rhs)
+        {
+            if constexpr (Op == ArrayOp::eAdd) {
+                return _mm_add_pd(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eSubtract) {
+                return _mm_sub_pd(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eMultiply) {
+                return _mm_mul_pd(lhs, rhs);
+            } else {
+                return _mm_div_pd(lhs, rhs);
+            }
+        }
+    };
+
+    template <>
+    struct Sse2<Int32> {
+        using Register = __m128i;
+        static constexpr size_t kWidth = 4;
+
+        // 32-bit multiplies need SSE4.1, and no x86 set divides integers
+        template <ArrayOp Op>
+        static constexpr bool kSupports = Op == ArrayOp::eAdd || Op == ArrayOp::eSubtract;
+
+        static Register load(const Int32* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+        static void store(Int32* ptr, Register value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), value); }
+
+        template <ArrayOp Op>
+        static Register apply(Register lhs, Register rhs)
+        {
+            if constexpr (Op == ArrayOp::eAdd) {
+                return _mm_add_epi32(lhs, rhs);
+            } else {
+                return _mm_sub_epi32(lhs, rhs);
+            }
+        }
+    };
+
+    template <typename Type>
+    struct Avx2;
+
+    template <>
+    struct Avx2<Float> {
+        using Register = __m256;
+        static constexpr size_t kWidth = 8;
+
+        template <ArrayOp Op>
+        static constexpr bool kSupports = true;
+
+        CF_CORE_TARGET_AVX2 static Register load(const Float* ptr) { return _mm256_loadu_ps(ptr); }
+        CF_CORE_TARGET_AVX2 static void store(Float* ptr, Register value) { _mm256_storeu_ps(ptr, value); }
+
+        template <ArrayOp Op>
+        CF_CORE_TARGET_AVX2 static Register apply(Register lhs, Register rhs)
+        {
+            if constexpr (Op == ArrayOp::eAdd) {
+                return _mm256_add_ps(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eSubtract) {
+                return _mm256_sub_ps(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eMultiply) {
+                return _mm256_mul_ps(lhs, rhs);
+            } else {
+                return _mm256_div_ps(lhs, rhs);
+            }
+        }
+    };
+
+    template <>
+    struct Avx2<Double> {
+        using Register = __m256d;
+        static constexpr size_t kWidth = 4;
+
+        template <ArrayOp Op>
+        static constexpr bool kSupports = true;
+
+        CF_CORE_TARGET_AVX2 static Register load(const Double* ptr) { return _mm256_loadu_pd(ptr); }
+        CF_CORE_TARGET_AVX2 static void store(Double* ptr, Register value) { _mm256_storeu_pd(ptr, value); }
+
+        template <ArrayOp Op>
+        CF_CORE_TARGET_AVX2 static Register apply(Register lhs, Register rhs)
+        {
+            if constexpr (Op == ArrayOp::eAdd) {
+                return _mm256_add_pd(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eSubtract) {
+                return _mm256_sub_pd(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eMultiply) {
+                return _mm256_mul_pd(lhs, rhs);
+            } else {
+                return _mm256_div_pd(lhs, rhs);
+            }
+        }
+    };
+
+    template <>
+    struct Avx2<Int32> {
+        using Register = __m256i;
+        static constexpr size_t kWidth = 8;
+
+        template <ArrayOp Op>
+        static constexpr bool kSupports = Op != ArrayOp::eDivide;
+
+        CF_CORE_TARGET_AVX2 static Register load(const Int32* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+        CF_CORE_TARGET_AVX2 static void store(Int32* ptr, Register value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+
+        template <ArrayOp Op>
+        CF_CORE_TARGET_AVX2 static Register apply(Register lhs, Register rhs)
+        {
+            if constexpr (Op == ArrayOp::eAdd) {
+                return _mm256_add_epi32(lhs, rhs);
+            } else if constexpr (Op == ArrayOp::eSubtract) {
+                return _mm256_sub_epi32(lhs, rhs);
+            } else {
+                return _mm256_mullo_epi32(lhs, rhs);
+            }
+        }
+    };
+
+    // The loops are the same for both sets, but an AVX2 loop must itself be
+    // compiled for AVX2 to inline the register operations
+    template <ArrayOp Op, typename Type>
+    void computeSse2(const Type* lhs, const Type* rhs, Type* out, size_t count)
+    {
+        using Simd = Sse2<Type>;
+        size_t i = 0;
+        for (; i + Simd::kWidth <= count; i += Simd::kWidth) {
+            Simd::store(out + i, Simd::template apply<Op>(Simd::load(lhs + i), Simd::load(rhs + i)));
+        }
+        computeScalar<Op>(lhs + i, rhs + i, out + i, count - i);
+    }
+
+    template <ArrayOp Op, typename Type>
+    CF_CORE_TARGET_AVX2 void computeAvx2(const Type* lhs, const Type* rhs, Type* out, size_t count)
+    {
+        using Simd = Avx2<Type>;
+        size_t i = 0;
+        for (; i + Simd::kWidth <= count; i += Simd::kWidth) {
+            Simd::store(out + i, Simd::template apply<Op>(Simd::load(lhs + i), Simd::load(rhs + i)));
+        }
+        computeScalar<Op>(lhs + i, rhs + i, out + i, count - i);
+    }
+
+#endif // CF_CORE_SIMD_X86
+
+    SimdLevel detectSimdLevel()
+    {
+#if defined(CF_CORE_SIMD_X86) && defined(_MSC_VER)
+        // AVX2 needs the CPU to support it and the OS to save the YMM registers
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return SimdLevel::eSSE2;
+        }
+
+        __cpuid(info, 1);
+        const bool hasOsXSave = (info[2] & (1 << 27)) != 0;
+        const bool hasAvx = (info[2] & (1 << 28)) != 0;
+        if (!hasOsXSave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6) {
+            return SimdLevel::eSSE2;
+        }
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0 ? SimdLevel::eAVX2 : SimdLevel::eSSE2;
+#elif defined(CF_CORE_SIMD_X86)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::eAVX2 : SimdLevel::eSSE2;
+#else
+        return SimdLevel::eScalar;
+#endif
+    }
+
+    template <ArrayOp Op, typename Type>
+    ArrayKernel<Type> selectKernel([[maybe_unused]] SimdLevel level)
+    {
+#ifdef CF_CORE_SIMD_X86
+        if constexpr (Avx2<Type>::template kSupports<Op>) {
+            if (level == SimdLevel::eAVX2) {
+                return &computeAvx2<Op, Type>;
+            }
+        }
+        if constexpr (Sse2<Type>::template kSupports<Op>) {
+            if (level != SimdLevel::eScalar) {
+                return &computeSse2<Op, Type>;
+            }
+        }
+#endif
+        return &computeScalar<Op, Type>;
+    }
+
+    // Indexed by ArrayOp
+    template <typename Type>
+    struct KernelTable {
+        ArrayKernel<Type> kernels[4];
+
+        explicit KernelTable(SimdLevel level)
+            : kernels {
+                selectKernel<ArrayOp::eAdd, Type>(level),
+                selectKernel<ArrayOp::eSubtract, Type>(level),
+                selectKernel<ArrayOp::eMultiply, Type>(level),
+                selectKernel<ArrayOp::eDivide, Type>(level)
+            }
+        {
+        }
+    };
+
+    template <typename Type>
+    void checkSizes(std::span<const Type> lhs, std::span<const Type> rhs, std::span<Type> out)
+    {
+        if (lhs.size() != rhs.size() || lhs.size() != out.size()) {
+            throw std::runtime_error("Array size mismatch in computeArray: " + std::to_string(lhs.size()) + ", "
+                + std::to_string(rhs.size()) + " and " + std::to_string(out.size()));
+        }
+    }
+
+    template <typename Type>
+    void dispatch(ArrayOp op, std::span<const Type> lhs, std::span<const Type> rhs, std::span<Type> out)
+    {
+        checkSizes(lhs, rhs, out);
+
+        static const KernelTable<Type> table(getSimdLevel());
+        table.kernels[static_cast<size_t>(op)](lhs.data(), rhs.data(), out.data(), out.size());
+    }
+
+    template <typename Type>
+    void dispatch(SimdLevel level, ArrayOp op, std::span<const Type> lhs, std::span<const Type> rhs, std::span<Type> out)
+    {
+        if (level > getSimdLevel()) {
+            throw std::runtime_error("Unsupported SIMD level in computeArray: " + std::to_string(static_cast<int>(level)));
+        }
+        checkSizes(lhs, rhs, out);
+
+        // Indexed by SimdLevel
+        static const KernelTable<Type> tables[] {
+            KernelTable<Type>(SimdLevel::eScalar),
+            KernelTable<Type>(SimdLevel::eSSE2),
+            KernelTable<Type>(SimdLevel::eAVX2)
+        };
+        tables[static_cast<size_t>(level)].kernels[static_cast<size_t>(op)](lhs.data(), rhs.data(), out.data(), out.size());
+    }
+
+} // namespace
+
+SimdLevel getSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+void computeArray(ArrayOp op, std::span<const Float> lhs, std::span<const Float> rhs, std::span<Float> out)
+{
+    dispatch(op, lhs, rhs, out);
+}
+
+void computeArray(ArrayOp op, std::span<const Double> lhs, std::span<const Double> rhs, std::span<Double> out)
+{
+    dispatch(op, lhs, rhs, out);
+}
+
+void computeArray(ArrayOp op, std::span<const Int32> lhs, std::span<const Int32> rhs, std::span<Int32> out)
+{
+    dispatch(op, lhs, rhs, out);
+}
+
+void computeArray(SimdLevel level, ArrayOp op, std::span<const Float> lhs, std::span<const Float> rhs, std::span<Float> out)
+{
+    dispatch(level, op, lhs, rhs, out);
+}
+
+void computeArray(SimdLevel level, ArrayOp op, std::span<const Double> lhs, std::span<const Double> rhs, std::span<Double> out)
+{
+    dispatch(level, op, lhs, rhs, out);
+}
+
+void computeArray(SimdLevel level, ArrayOp op, std::span<const Int32> lhs, std::span<const Int32> rhs, std::span<Int32> out)
+{
+    dispatch(level, op, lhs, rhs, out);
+}
+
+} // namespace cf::core
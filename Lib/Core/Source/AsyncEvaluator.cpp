@@ -0,0 +1,231 @@
+#include "AsyncEvaluator.hpp"
+#include "Core/Events/AttributeEvent.hpp"
+#include "Core/Events/ConnectionAddedEvent.hpp"
+#include "Core/Events/NodeEvent.hpp"
+#include "Scene.hpp"
+
+namespace cf::core {
+
+AsyncEvaluator::AsyncEvaluator(Scene& scene)
+    : m_scene(scene)
+{
+    m_scene.setEvaluateOnChange(false);
+
+    m_subscriptions.push_back(EventBus::subscribe<AttributeEvent>([this](const AttributeEvent& event) {
+        if (event.m_message == AttributeEvent::AttributeMessage::eAttributeChanged) {
+            onAttributeChanged(event.attributeHandle);
+        }
+    }));
+    m_subscriptions.push_back(EventBus::subscribe<ConnectionAddedEvent>([this](const ConnectionAddedEvent&) {
+        requestEvaluation();
+    }));
+    m_subscriptions.push_back(EventBus::subscribe<ConnectionRemovedEvent>([this](const ConnectionRemovedEvent&) {
+        requestEvaluation();
+    }));
+    m_subscriptions.push_back(EventBus::subscribe<NodeEvent>([this](const NodeEvent&) {
+        requestEvaluation();
+    }));
+
+    m_worker = std::thread([this] { workerLoop(); });
+    requestEvaluation();
+}
+
+AsyncEvaluator::~AsyncEvaluator()
+{
+    for (const auto& subId : m_subscriptions) {
+        EventBus::unsubscribe(subId);
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+    m_worker.join();
+
+    m_scene.setEvaluateOnChange(true);
+}
+
+void AsyncEvaluator::setCompletionCallback(CompletionCallback callback)
+{
+    std::lock_guard lock(m_mutex);
+    m_callback = std::move(callback);
+}
+
+void AsyncEvaluator::requestEvaluation()
+{
+    auto plan = m_scene.getSharedExecutionPlan();
+    if (plan == m_plan) {
+        return;
+    }
+
+    // The scene is never evaluated while this evaluator exists, so its dirty
+    // nodes are exactly the ones the new context has to recompute
+    auto context = std::make_unique<EvaluationContext>(m_scene);
+    m_plan = std::move(plan);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_pendingContext = std::move(context);
+        m_pendingEdits.clear();
+        m_cancellation.cancel();
+    }
+    m_wakeUp.notify_one();
+}
+
+std::shared_ptr<const EvaluationSnapshot> AsyncEvaluator::getSnapshot() const
+{
+    std::lock_guard lock(m_snapshotMutex);
+    return m_snapshot;
+}
+
+void AsyncEvaluator::waitUntilIdle()
+{
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] {
+        return !m_isBusy && !m_pendingContext && m_pendingEdits.empty();
+    });
+}
+
+void AsyncEvaluator::onAttributeChanged(AttributeHandle handle)
+{
+    auto attribute = m_scene.getAttribute(handle);
+    if (!attribute) {
+        return;
+    }
+
+    // A new context already starts from the edited value
+    if (m_scene.getSharedExecutionPlan() != m_plan) {
+        requestEvaluation();
+        return;
+    }
+
+    const TypeDescriptor& desc = attribute->getTypeDescriptor();
+    std::shared_ptr<void> value(desc.create(), desc.destroy);
+    desc.copy(value.get(), attribute->getData());
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_pendingEdits[handle] = std::move(value);
+        m_cancellation.cancel();
+    }
+    m_wakeUp.notify_one();
+}
+
+void AsyncEvaluator::workerLoop()
+{
+    while (true) {
+        std::unique_ptr<EvaluationContext> newContext;
+        std::unordered_map<AttributeHandle, std::shared_ptr<void>> edits;
+        CancellationToken cancellation;
+        {
+            std::unique_lock lock(m_mutex);
+            m_wakeUp.wait(lock, [this] {
+                return m_stopping || m_pendingContext || !m_pendingEdits.empty();
+            });
+
+            if (m_stopping) {
+                return;
+            }
+
+            newContext = std::move(m_pendingContext);
+            edits.swap(m_pendingEdits);
+            m_cancellation = cancellation;
+            m_isBusy = true;
+        }
+
+        if (newContext) {
+            m_context = std::move(newContext);
+            m_isContextPublished = false;
+            m_unpublishedChanges.clear();
+        }
+
+        for (const auto& [handle, value] : edits) {
+            m_context->setRawValue(handle, value.get());
+            m_unpublishedChanges.push_back(handle);
+        }
+
+        EvaluationStatus status = EvaluationStatus::eComplete;
+        try {
+            status = m_context->evaluate(cancellation);
+        } catch (const std::exception& e) {
+            spdlog::error("AsyncEvaluator - Evaluation failed: {}", e.what());
+        }
+
+        const auto& written = m_context->getChangedAttributes();
+        m_unpublishedChanges.insert(m_unpublishedChanges.end(), written.begin(), written.end());
+
+        // A cancelled evaluation is superseded by the edits that cancelled it
+        if (status == EvaluationStatus::eComplete) {
+            auto snapshot = publishSnapshot(!m_isContextPublished, std::move(m_unpublishedChanges));
+            m_isContextPublished = true;
+            m_unpublishedChanges.clear();
+
+            CompletionCallback callback;
+            {
+                std::lock_guard lock(m_mutex);
+                callback = m_callback;
+            }
+            if (callback) {
+                callback(std::move(snapshot));
+            }
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_isBusy = false;
+        }
+        m_idle.notify_all();
+    }
+}
+
+std::shared_ptr<const EvaluationSnapshot> AsyncEvaluator::publishSnapshot(bool isNewContext, std::vector<AttributeHandle> changed)
+{
+    auto previous = getSnapshot();
+    auto snapshot = std::make_shared<EvaluationSnapshot>();
+    snapshot->m_generation = previous ? previous->m_generation + 1 : 1;
+
+    auto copyValue = [](TypeHandle typeHandle, const void* value) {
+        const TypeDescriptor& desc = TypeRegistry::getTypeDescriptor(typeHandle);
+        std::shared_ptr<void> copy(desc.create(), desc.destroy);
+        desc.copy(copy.get(), value);
+        return std::shared_ptr<const void>(std::move(copy));
+    };
+
+    if (isNewContext || !previous) {
+        m_context->forEachValue([&](AttributeHandle handle, TypeHandle typeHandle, const void* value) {
+            const uint32_t index = getSlotIndex(handle);
+            if (index >= snapshot->m_values.size()) {
+                snapshot->m_handles.resize(index + 1, kInvalidAttributeHandle);
+                snapshot->m_values.resize(index + 1);
+                snapshot->m_types.resize(index + 1, kInvalidTypeHandle);
+            }
+            snapshot->m_handles[index] = handle;
+            snapshot->m_values[index] = copyValue(typeHandle, value);
+            snapshot->m_types[index] = typeHandle;
+            snapshot->m_changed.push_back(handle);
+        });
+    } else {
+        snapshot->m_handles = previous->m_handles;
+        snapshot->m_values = previous->m_values;
+        snapshot->m_types = previous->m_types;
+
+        std::ranges::sort(changed);
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+        for (AttributeHandle handle : changed) {
+            const uint32_t index = getSlotIndex(handle);
+            snapshot->m_values[index] = copyValue(snapshot->m_types[index], m_context->findRawValue(handle));
+        }
+        snapshot->m_changed = std::move(changed);
+    }
+
+    {
+        std::lock_guard lock(m_snapshotMutex);
+        m_snapshot = snapshot;
+    }
+
+    return snapshot;
+}
+
+} // namespace cf::core
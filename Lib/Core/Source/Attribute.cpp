@@ -1,8 +1,76 @@
 #include "Attribute.hpp"
 #include "Core/Events/AttributeEvent.hpp"
+#include "Core/SlotMap.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 namespace cf::core {
 
+namespace {
+
+// Open scopes in creation order. Scopes owned by transactions can be released
+// out of order, so each one removes itself wherever it is.
+thread_local std::vector<AttributeChangeCapture*> t_captures;
+thread_local const std::vector<void*>* t_storage = nullptr;
+thread_local std::vector<AttributeEditRecorder*> t_editRecorders;
+
+template <typename Scope>
+void removeScope(std::vector<Scope*>& scopes, Scope* scope)
+{
+    auto it = std::ranges::find(scopes.rbegin(), scopes.rend(), scope);
+    if (it != scopes.rend()) {
+        scopes.erase(std::next(it).base());
+    }
+}
+
+} // namespace
+
+AttributeChangeCapture::AttributeChangeCapture(std::vector<AttributeHandle>& changes)
+    : m_changes(&changes)
+{
+    t_captures.push_back(this);
+}
+
+AttributeChangeCapture::~AttributeChangeCapture()
+{
+    removeScope(t_captures, this);
+}
+
+AttributeStorageScope::AttributeStorageScope(const std::vector<void*>& values)
+    : m_previous(t_storage)
+{
+    t_storage = &values;
+}
+
+AttributeStorageScope::~AttributeStorageScope()
+{
+    t_storage = m_previous;
+}
+
+AttributeEditRecorder::AttributeEditRecorder()
+{
+    t_editRecorders.push_back(this);
+}
+
+AttributeEditRecorder::~AttributeEditRecorder()
+{
+    removeScope(t_editRecorders, this);
+}
+
+void AttributeEditRecorder::record(const Attribute& attribute, const void* value)
+{
+    if (!m_recorded.insert(&attribute).second) {
+        return;
+    }
+
+    const TypeDescriptor& desc = attribute.getTypeDescriptor();
+    std::shared_ptr<void> previousValue(desc.create(), desc.destroy);
+    desc.copy(previousValue.get(), value);
+
+    m_edits.push_back(AttributeEdit { &attribute, attribute.getHandle(), std::move(previousValue) });
+}
+
 Attribute::Attribute()
     : m_handle(kInvalidAttributeHandle)
     , m_descriptorHandle(kInvalidAttributeHandle)
@@ -10,51 +78,119 @@ Attribute::Attribute()
 {
 }
 
-Attribute::Attribute(AttributeDescriptor desc, AttributeHandle attributeHandle)
+Attribute::Attribute(const AttributeDescriptor& desc, AttributeHandle attributeHandle)
     : m_handle(attributeHandle)
     , m_descriptorHandle(desc.handle)
     , data(nullptr)
+    , m_typeHandle(desc.typeHandle)
+    , m_descriptor(TypeRegistry::findAttributeDescriptor(desc.handle))
+    , m_typeDescriptor(&TypeRegistry::getTypeDescriptor(desc.typeHandle))
+{
+    createOwnedValue();
+}
+
+Attribute::Attribute(const AttributeDescriptor& desc, AttributeHandle attributeHandle, void* storage)
+    : m_handle(attributeHandle)
+    , m_descriptorHandle(desc.handle)
+    , data(storage)
+    , m_typeHandle(desc.typeHandle)
+    , m_descriptor(TypeRegistry::findAttributeDescriptor(desc.handle))
+    , m_typeDescriptor(&TypeRegistry::getTypeDescriptor(desc.typeHandle))
+    , m_ownsValue(false)
 {
-    data = TypeRegistry::getTypeDescriptor(desc.typeHandle).create();
 }
 
 Attribute::~Attribute()
 {
-    // TODO: Implement destruction of different data types
-    if (data) {
-        TypeRegistry::getTypeDescriptor(getAttributeDescriptor().typeHandle).destroy(data);
-        data = nullptr;
+    if (!m_ownsValue) {
+        return;
     }
+
+    if (isValueInline()) {
+        m_typeDescriptor->destroyAt(data);
+    } else if (data) {
+        m_typeDescriptor->destroy(data);
+    }
+    data = nullptr;
 }
 
-void Attribute::copyDataFrom(const std::shared_ptr<Attribute>& other)
+void Attribute::createOwnedValue()
 {
-    if (!other || !other->data || !data) {
-        throw std::runtime_error("Null data pointer in copyDataFrom");
+    if (m_typeDescriptor->size <= kInlineStorageSize && m_typeDescriptor->alignment <= alignof(std::max_align_t)) {
+        m_typeDescriptor->constructAt(m_inlineStorage);
+        data = m_inlineStorage;
+    } else {
+        data = m_typeDescriptor->create();
     }
-    if (getTypeHandle() != other->getTypeHandle()) {
-        throw std::runtime_error("Type mismatch in copyDataFrom");
+}
+
+void* Attribute::detachStorage()
+{
+    if (m_ownsValue) {
+        return nullptr;
     }
 
-    // Use reflection to copy the data
-    const auto& typeDesc = TypeRegistry::getTypeDescriptor(getTypeHandle());
-    typeDesc.copy(data, other->data);
+    void* storage = data;
+    createOwnedValue();
+    m_typeDescriptor->copy(data, storage);
+    m_ownsValue = true;
 
-    publishAttributeChanged(m_handle);
+    return storage;
+}
+
+void Attribute::attachStorage(void* storage)
+{
+    m_typeDescriptor->copy(storage, data);
+    if (m_ownsValue) {
+        if (isValueInline()) {
+            m_typeDescriptor->destroyAt(data);
+        } else {
+            m_typeDescriptor->destroy(data);
+        }
+    }
+
+    data = storage;
+    m_ownsValue = false;
+}
+
+void Attribute::copyDataFrom(const std::shared_ptr<Attribute>& other)
+{
+    if (!other) {
+        throw std::runtime_error("Null data pointer in copyDataFrom");
+    }
+
+    copyDataFrom(*other);
 }
 
 void Attribute::copyDataFrom(const Attribute& other)
 {
-    if (!other.data || !data) {
+    void* target = resolveData();
+    const void* source = other.resolveReadData();
+    if (!source || !target) {
         throw std::runtime_error("Null data pointer in copyDataFrom");
     }
     if (getTypeHandle() != other.getTypeHandle()) {
         throw std::runtime_error("Type mismatch in copyDataFrom");
     }
 
+    recordWrite(target);
+
     // Use reflection to copy the data
-    const auto& typeDesc = TypeRegistry::getTypeDescriptor(getTypeHandle());
-    typeDesc.copy(data, other.data);
+    m_typeDescriptor->copy(target, source);
+
+    publishAttributeChanged(m_handle);
+}
+
+void Attribute::setRawValue(const void* value)
+{
+    void* target = resolveData();
+    if (!value || !target) {
+        throw std::runtime_error("Null data pointer in setRawValue");
+    }
+
+    recordWrite(target);
+
+    m_typeDescriptor->copy(target, value);
 
     publishAttributeChanged(m_handle);
 }
@@ -68,18 +204,65 @@ AttributeHandle Attribute::getHandle() const
     return m_handle;
 }
 
-TypeHandle Attribute::getTypeHandle() const
+const AttributeDescriptor& Attribute::getAttributeDescriptor() const
 {
-    return getAttributeDescriptor().typeHandle;
+    return m_descriptor ? *m_descriptor : TypeRegistry::getAttributeDescriptor(m_descriptorHandle);
 }
 
-AttributeDescriptor Attribute::getAttributeDescriptor() const
+void* Attribute::resolveData() const
 {
-    return TypeRegistry::getAttributeDescriptor(m_descriptorHandle);
+    const uint32_t index = getSlotIndex(m_handle);
+    if (t_storage && index < t_storage->size() && (*t_storage)[index]) {
+        return (*t_storage)[index];
+    }
+
+    return data;
+}
+
+const void* Attribute::resolveReadData() const
+{
+    // A scope holds values for connected inputs as well, so it comes first
+    const uint32_t index = getSlotIndex(m_handle);
+    if (t_storage && index < t_storage->size() && (*t_storage)[index]) {
+        return (*t_storage)[index];
+    }
+
+    return m_source ? m_source->resolveReadData() : data;
+}
+
+void Attribute::setSource(const Attribute* source)
+{
+    // The source's storage is read as this attribute's type
+    if (source && source->getTypeHandle() != m_typeHandle) {
+        throw std::runtime_error("Type mismatch in setSource");
+    }
+
+    if (m_source && !source) {
+        m_typeDescriptor->copy(data, m_source->resolveReadData());
+    }
+
+    m_source = source;
+}
+
+void Attribute::recordWrite(const void* currentValue) const
+{
+    // Values of an evaluation context are not the attribute's own
+    if (t_editRecorders.empty() || currentValue != data) {
+        return;
+    }
+
+    for (AttributeEditRecorder* recorder : t_editRecorders) {
+        recorder->record(*this, currentValue);
+    }
 }
 
 void Attribute::publishAttributeChanged(AttributeHandle handle)
 {
+    if (!t_captures.empty()) {
+        t_captures.back()->m_changes->push_back(handle);
+        return;
+    }
+
     EventBus::publish(AttributeEvent {
         AttributeEvent::AttributeMessage::eAttributeChanged, handle });
 }
@@ -0,0 +1,96 @@
+#include "AttributeStorage.hpp"
+#include "TypeRegistry.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace cf::core {
+
+AttributeStorage::~AttributeStorage()
+{
+    // The arena frees the chunks themselves when it is destroyed
+    for (auto& [typeHandle, column] : m_columns) {
+        for (uint32_t slot = 0; slot < column.isLive.size(); ++slot) {
+            if (column.isLive[slot]) {
+                column.type->destroyAt(column.getSlot(slot));
+            }
+        }
+    }
+}
+
+void* AttributeStorage::allocate(TypeHandle typeHandle)
+{
+    Column& column = m_columns[typeHandle];
+    if (!column.type) {
+        column.type = &TypeRegistry::getTypeDescriptor(typeHandle);
+    }
+
+    uint32_t slot = 0;
+    if (!column.freeSlots.empty()) {
+        slot = column.freeSlots.back();
+        column.freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(column.isLive.size());
+        if (slot == column.chunks.size() * kChunkCapacity) {
+            auto* chunk = static_cast<std::byte*>(m_arena.allocate(column.type->size * kChunkCapacity, column.type->alignment));
+            column.chunks.push_back(chunk);
+
+            auto position = std::ranges::lower_bound(column.chunksByAddress, chunk, {}, &std::pair<const std::byte*, uint32_t>::first);
+            column.chunksByAddress.insert(position, { chunk, static_cast<uint32_t>(column.chunks.size() - 1) });
+        }
+        column.isLive.push_back(false);
+    }
+
+    void* value = column.getSlot(slot);
+    column.type->constructAt(value);
+    column.isLive[slot] = true;
+    ++column.liveCount;
+
+    return value;
+}
+
+void AttributeStorage::release(TypeHandle typeHandle, void* value)
+{
+    auto it = m_columns.find(typeHandle);
+    if (it == m_columns.end()) {
+        throw std::runtime_error("AttributeStorage::release - No column for type: " + std::to_string(typeHandle));
+    }
+
+    Column& column = it->second;
+    const uint32_t slot = findSlot(column, value);
+    if (!column.isLive[slot]) {
+        throw std::runtime_error("AttributeStorage::release - Value already released");
+    }
+
+    column.type->destroyAt(value);
+    column.isLive[slot] = false;
+    column.freeSlots.push_back(slot);
+    --column.liveCount;
+}
+
+size_t AttributeStorage::getValueCount(TypeHandle typeHandle) const
+{
+    auto it = m_columns.find(typeHandle);
+    return it != m_columns.end() ? it->second.liveCount : 0;
+}
+
+uint32_t AttributeStorage::findSlot(const Column& column, const void* value) const
+{
+    const auto* address = static_cast<const std::byte*>(value);
+
+    // Last chunk starting at or before the value
+    auto it = std::ranges::upper_bound(column.chunksByAddress, address, {}, &std::pair<const std::byte*, uint32_t>::first);
+    if (it != column.chunksByAddress.begin()) {
+        const auto& [chunk, chunkIndex] = *std::prev(it);
+        const uintptr_t offset = reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(chunk);
+        const uint32_t slot = chunkIndex * kChunkCapacity + static_cast<uint32_t>(offset / column.type->size);
+        if (offset < column.type->size * kChunkCapacity && offset % column.type->size == 0 && slot < column.isLive.size()) {
+            return slot;
+        }
+    }
+
+    throw std::runtime_error("AttributeStorage::release - Value not allocated by this storage");
+}
+
+} // namespace cf::core
@@ -0,0 +1,174 @@
+#include "EvaluationContext.hpp"
+#include "Scene.hpp"
+
+namespace cf::core {
+
+EvaluationContext::EvaluationContext(Scene& scene)
+    : m_plan(scene.getSharedExecutionPlan())
+{
+    const uint32_t slotCount = scene.getAttributes().getSlotCount();
+    m_handles.resize(slotCount, kInvalidAttributeHandle);
+    m_values.resize(slotCount, nullptr);
+    m_ownedValues.resize(slotCount, nullptr);
+    m_types.resize(slotCount, kInvalidTypeHandle);
+    m_attributeSteps.resize(slotCount, 0);
+
+    for (const auto& [handle, attribute] : scene.getAttributes()) {
+        const TypeHandle typeHandle = attribute->getTypeHandle();
+        const TypeDescriptor& desc = TypeRegistry::getTypeDescriptor(typeHandle);
+        const uint32_t index = getSlotIndex(handle);
+
+        m_handles[index] = handle;
+        m_ownedValues[index] = desc.create();
+        desc.copy(m_ownedValues[index], attribute->getValueData());
+        m_values[index] = m_ownedValues[index];
+        m_types[index] = typeHandle;
+        m_attributeSteps[index] = m_plan->stepIndex.at(scene.getAttributeNode(handle));
+    }
+
+    // Links come from the plan rather than the scene's attributes, so the
+    // context never follows sources the scene rewires while it evaluates.
+    // Later links to the same input win, as in the scene.
+    for (const ExecutionLink& link : m_plan->links) {
+        m_values[getSlotIndex(link.targetHandle)] = m_ownedValues[getSlotIndex(link.sourceHandle)];
+    }
+
+    m_dirtySteps.resize(m_plan->steps.size(), false);
+    for (uint32_t i = 0; i < m_plan->steps.size(); ++i) {
+        if (scene.isDirty(m_plan->steps[i].handle)) {
+            m_dirtySteps[i] = true;
+            ++m_dirtyCount;
+        }
+    }
+}
+
+EvaluationContext::~EvaluationContext()
+{
+    for (size_t index = 0; index < m_ownedValues.size(); ++index) {
+        if (m_ownedValues[index]) {
+            TypeRegistry::getTypeDescriptor(m_types[index]).destroy(m_ownedValues[index]);
+        }
+    }
+}
+
+void EvaluationContext::setRawValue(AttributeHandle handle, const void* value)
+{
+    if (!contains(handle)) {
+        throw std::runtime_error("Attribute not part of EvaluationContext: " + std::to_string(handle));
+    }
+
+    const uint32_t index = getSlotIndex(handle);
+    void* target = getOwnedStorage(handle, m_types[index]);
+    TypeRegistry::getTypeDescriptor(m_types[index]).copy(target, value);
+    markStepDirty(m_attributeSteps[index]);
+}
+
+const void* EvaluationContext::findRawValue(AttributeHandle handle) const
+{
+    return contains(handle) ? m_values[getSlotIndex(handle)] : nullptr;
+}
+
+EvaluationStatus EvaluationContext::evaluate()
+{
+    return evaluateDirty(EvaluationStopCondition {});
+}
+
+EvaluationStatus EvaluationContext::evaluate(const CancellationToken& token, std::optional<std::chrono::steady_clock::duration> budget)
+{
+    return evaluateDirty(EvaluationStopCondition { &token, budget });
+}
+
+EvaluationStatus EvaluationContext::evaluateDirty(const EvaluationStopCondition& stopCondition)
+{
+    m_changes.clear();
+    if (m_dirtyCount == 0) {
+        return EvaluationStatus::eComplete;
+    }
+
+    // Nodes read and write their attributes as usual; the scope redirects
+    // them to this context's values on the current thread
+    AttributeStorageScope storage(m_values);
+    AttributeChangeCapture capture(m_changes);
+
+    const ExecutionPlan& plan = *m_plan;
+    bool hasComputed = false;
+    for (uint32_t stepIndex = 0; stepIndex < plan.steps.size(); ++stepIndex) {
+        if (!m_dirtySteps[stepIndex]) {
+            continue;
+        }
+
+        // Steps run in topological order, so the ones left dirty keep their
+        // downstream dirty as well
+        const EvaluationStatus stopStatus = stopCondition.check(hasComputed);
+        if (stopStatus != EvaluationStatus::eComplete) {
+            return stopStatus;
+        }
+
+        const ExecutionStep& step = plan.steps[stepIndex];
+        plan.collectLinkChanges(step, m_changes);
+
+        Status status = step.node->compute();
+        if (status != Status::eOK) {
+            spdlog::error("Node '{}' computation failed with status: {}", step.node->getName(), static_cast<int>(status));
+        }
+
+        m_dirtySteps[stepIndex] = false;
+        --m_dirtyCount;
+        hasComputed = true;
+    }
+
+    return EvaluationStatus::eComplete;
+}
+
+bool EvaluationContext::isDirty(NodeHandle nodeHandle) const
+{
+    auto it = m_plan->stepIndex.find(nodeHandle);
+    return it != m_plan->stepIndex.end() && m_dirtySteps[it->second];
+}
+
+void* EvaluationContext::getStorage(AttributeHandle handle, TypeHandle typeHandle) const
+{
+    if (!contains(handle)) {
+        throw std::runtime_error("Attribute not part of EvaluationContext: " + std::to_string(handle));
+    }
+    if (m_types[getSlotIndex(handle)] != typeHandle) {
+        throw std::runtime_error("Type mismatch in EvaluationContext");
+    }
+
+    return m_values[getSlotIndex(handle)];
+}
+
+void* EvaluationContext::getOwnedStorage(AttributeHandle handle, TypeHandle typeHandle) const
+{
+    getStorage(handle, typeHandle);
+    return m_ownedValues[getSlotIndex(handle)];
+}
+
+bool EvaluationContext::contains(AttributeHandle handle) const
+{
+    const uint32_t index = getSlotIndex(handle);
+    return index < m_handles.size() && m_handles[index] == handle && handle != kInvalidAttributeHandle;
+}
+
+void EvaluationContext::markStepDirty(uint32_t stepIndex)
+{
+    std::vector<uint32_t> pending { stepIndex };
+    while (!pending.empty()) {
+        const uint32_t current = pending.back();
+        pending.pop_back();
+
+        // An already dirty step has its downstream dirty as well
+        if (m_dirtySteps[current]) {
+            continue;
+        }
+        m_dirtySteps[current] = true;
+        ++m_dirtyCount;
+
+        const ExecutionStep& step = m_plan->steps[current];
+        for (uint32_t i = step.firstSuccessor; i < step.firstSuccessor + step.successorCount; ++i) {
+            pending.push_back(m_plan->successors[i]);
+        }
+    }
+}
+
+} // namespace cf::core
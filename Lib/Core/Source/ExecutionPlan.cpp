@@ -0,0 +1,47 @@
+#include "ExecutionPlan.hpp"
+#include "Scene.hpp"
+
+namespace cf::core {
+
+ExecutionPlan ExecutionPlan::compile(const Scene& scene)
+{
+    ExecutionPlan plan;
+
+    const auto& order = scene.topologicalOrder();
+    plan.steps.reserve(order.size());
+    plan.stepIndex.reserve(order.size());
+    plan.nodes.reserve(order.size());
+
+    for (NodeHandle handle : order) {
+        plan.stepIndex[handle] = static_cast<uint32_t>(plan.steps.size());
+
+        ExecutionStep step;
+        step.handle = handle;
+        plan.nodes.push_back(scene.getNode(handle));
+        step.node = plan.nodes.back().get();
+        step.cache = scene.findResultCache(handle);
+        plan.steps.push_back(step);
+    }
+
+    for (auto& step : plan.steps) {
+        const ConnectionList& connections = scene.getNodeConnections(step.handle);
+
+        // The scene only accepts connections between live attributes of the
+        // same type, so links need no checks of their own
+        step.firstLink = static_cast<uint32_t>(plan.links.size());
+        for (const auto& conn : connections.incoming) {
+            plan.links.push_back(ExecutionLink { conn.attributeTarget, conn.attributeSource });
+        }
+        step.linkCount = static_cast<uint32_t>(plan.links.size()) - step.firstLink;
+
+        step.firstSuccessor = static_cast<uint32_t>(plan.successors.size());
+        for (const auto& conn : connections.outgoing) {
+            plan.successors.push_back(plan.stepIndex.at(conn.nodeTarget));
+        }
+        step.successorCount = static_cast<uint32_t>(plan.successors.size()) - step.firstSuccessor;
+    }
+
+    return plan;
+}
+
+} // namespace cf::core
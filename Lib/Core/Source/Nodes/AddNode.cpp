@@ -1,4 +1,5 @@
 #include "AddNode.hpp"
+#include "SampleBatch.hpp"
 #include "spdlog/spdlog.h"
 
 namespace cf::core {
@@ -10,4 +11,17 @@ Status AddNode::compute()
     return Status::eOK;
 }
 
+Status AddNode::computeBatch(SampleBatch& batch)
+{
+    std::span<const float> input1 = batch.getInput(inputs.input1);
+    std::span<const float> input2 = batch.getInput(inputs.input2);
+    std::span<float> result = batch.getOutput(outputs.result);
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = input1[i] + input2[i];
+    }
+
+    return Status::eOK;
+}
+
 } // namespace cf::core
\ No newline at end of file
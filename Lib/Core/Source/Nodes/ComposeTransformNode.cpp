@@ -0,0 +1,19 @@
+#include "ComposeTransformNode.hpp"
+
+namespace cf::core {
+
+Status ComposeTransformNode::compute()
+{
+    const Quat rotation = inputs.rotation;
+    const Vec3 scale = inputs.scale;
+
+    Mat4 transform = Mat4::Identity();
+    transform.topLeftCorner<3, 3>() = rotation.normalized().toRotationMatrix() * scale.asDiagonal();
+    transform.topRightCorner<3, 1>() = Vec3(inputs.translation);
+
+    outputs.transform = transform;
+
+    return Status::eOK;
+}
+
+} // namespace cf::core
@@ -0,0 +1,12 @@
+#include "MultiplyMatrixNode.hpp"
+
+namespace cf::core {
+
+Status MultiplyMatrixNode::compute()
+{
+    outputs.result = inputs.lhs * inputs.rhs;
+
+    return Status::eOK;
+}
+
+} // namespace cf::core
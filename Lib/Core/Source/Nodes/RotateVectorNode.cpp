@@ -0,0 +1,14 @@
+#include "RotateVectorNode.hpp"
+
+namespace cf::core {
+
+Status RotateVectorNode::compute()
+{
+    const Quat rotation = inputs.rotation;
+    const Vec3 vector = inputs.vector;
+    outputs.result = Vec3(rotation.normalized() * vector);
+
+    return Status::eOK;
+}
+
+} // namespace cf::core
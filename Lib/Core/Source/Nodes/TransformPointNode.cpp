@@ -0,0 +1,28 @@
+#include "TransformPointNode.hpp"
+#include "SampleBatch.hpp"
+
+namespace cf::core {
+
+Status TransformPointNode::compute()
+{
+    const Mat4 transform = inputs.transform;
+    const Vec3 point = inputs.point;
+    outputs.result = Vec3(transform.topLeftCorner<3, 3>() * point + transform.topRightCorner<3, 1>());
+
+    return Status::eOK;
+}
+
+Status TransformPointNode::computeBatch(SampleBatch& batch)
+{
+    std::span<const Mat4> transform = batch.getInput(inputs.transform);
+    std::span<const Vec3> point = batch.getInput(inputs.point);
+    std::span<Vec3> result = batch.getOutput(outputs.result);
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i].noalias() = transform[i].topLeftCorner<3, 3>() * point[i] + transform[i].topRightCorner<3, 1>();
+    }
+
+    return Status::eOK;
+}
+
+} // namespace cf::core
@@ -0,0 +1,104 @@
+#include "ResultCache.hpp"
+
+#include <algorithm>
+
+namespace cf::core {
+
+ResultCache::ResultCache(std::vector<Attribute*> inputs, std::vector<Attribute*> outputs, size_t capacity)
+    : m_inputs(std::move(inputs))
+    , m_outputs(std::move(outputs))
+    , m_capacity(capacity)
+{
+    for (const Attribute* input : m_inputs) {
+        m_inputTypes.push_back(input->getTypeDescriptor());
+    }
+    for (const Attribute* output : m_outputs) {
+        m_outputTypes.push_back(output->getTypeDescriptor());
+    }
+
+    m_entries.reserve(m_capacity);
+}
+
+bool ResultCache::canHash(const std::vector<Attribute*>& inputs)
+{
+    return std::ranges::all_of(inputs, [](const Attribute* input) {
+        return input->getTypeDescriptor().hash && input->getTypeDescriptor().equal;
+    });
+}
+
+uint64_t ResultCache::hashInputs() const
+{
+    uint64_t seed = m_inputs.size();
+    for (size_t i = 0; i < m_inputs.size(); ++i) {
+        const uint64_t value = m_inputTypes[i].hash(m_inputs[i]->getValueData());
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+
+    return seed;
+}
+
+bool ResultCache::restore(uint64_t inputHash)
+{
+    // std::hash of an integer is the integer itself, so different inputs can
+    // combine to the same hash
+    auto it = std::ranges::find_if(m_entries, [&](const Entry& entry) {
+        return entry.inputHash == inputHash && matchesInputs(entry);
+    });
+    if (it == m_entries.end()) {
+        ++m_stats.misses;
+        return false;
+    }
+
+    ++m_stats.hits;
+    std::rotate(m_entries.begin(), it, it + 1);
+
+    const Entry& entry = m_entries.front();
+    for (size_t i = 0; i < m_outputs.size(); ++i) {
+        m_outputs[i]->setRawValue(entry.outputs[i].get());
+    }
+
+    return true;
+}
+
+void ResultCache::store(uint64_t inputHash)
+{
+    if (m_capacity == 0) {
+        return;
+    }
+
+    // Reuse the storage of the evicted entry
+    if (m_entries.size() == m_capacity) {
+        std::rotate(m_entries.begin(), m_entries.end() - 1, m_entries.end());
+    } else {
+        Entry entry;
+        for (const TypeDescriptor& desc : m_inputTypes) {
+            entry.inputs.emplace_back(desc.create(), desc.destroy);
+        }
+        for (const TypeDescriptor& desc : m_outputTypes) {
+            entry.outputs.emplace_back(desc.create(), desc.destroy);
+        }
+        m_entries.insert(m_entries.begin(), std::move(entry));
+    }
+
+    Entry& entry = m_entries.front();
+    entry.inputHash = inputHash;
+    for (size_t i = 0; i < m_inputs.size(); ++i) {
+        m_inputTypes[i].copy(entry.inputs[i].get(), m_inputs[i]->getValueData());
+    }
+    for (size_t i = 0; i < m_outputs.size(); ++i) {
+        m_outputTypes[i].copy(entry.outputs[i].get(), m_outputs[i]->getData());
+    }
+}
+
+bool ResultCache::matchesInputs(const Entry& entry) const
+{
+    for (size_t i = 0; i < m_inputs.size(); ++i) {
+        if (!m_inputTypes[i].equal(entry.inputs[i].get(), m_inputs[i]->getValueData())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace cf::core
@@ -0,0 +1,253 @@
+#include "SampleBatch.hpp"
+#include "Scene.hpp"
+
+namespace cf::core {
+
+LaneArray::LaneArray(TypeHandle typeHandle, size_t laneCount)
+    : m_typeHandle(typeHandle)
+    , m_laneCount(laneCount)
+{
+    const TypeDescriptor& desc = TypeRegistry::getTypeDescriptor(typeHandle);
+    m_stride = desc.size;
+    m_data = desc.createArray(laneCount);
+    m_destroy = desc.destroyArray;
+}
+
+LaneArray::~LaneArray()
+{
+    if (m_data) {
+        m_destroy(m_data);
+    }
+}
+
+LaneArray::LaneArray(LaneArray&& other) noexcept
+    : m_typeHandle(other.m_typeHandle)
+    , m_laneCount(other.m_laneCount)
+    , m_stride(other.m_stride)
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_destroy(other.m_destroy)
+{
+}
+
+LaneArray& LaneArray::operator=(LaneArray&& other) noexcept
+{
+    if (this != &other) {
+        if (m_data) {
+            m_destroy(m_data);
+        }
+
+        m_typeHandle = other.m_typeHandle;
+        m_laneCount = other.m_laneCount;
+        m_stride = other.m_stride;
+        m_data = std::exchange(other.m_data, nullptr);
+        m_destroy = other.m_destroy;
+    }
+    return *this;
+}
+
+SampleBatch::SampleBatch(Scene& scene, size_t sampleCount)
+    : m_sampleCount(sampleCount)
+{
+    const ExecutionPlan& plan = scene.getExecutionPlan();
+
+    std::unordered_map<TypeHandle, uint32_t> copyFunctionIndex;
+    auto getCopyFunction = [&](TypeHandle typeHandle) {
+        auto [it, inserted] = copyFunctionIndex.try_emplace(typeHandle, static_cast<uint32_t>(m_copyFunctions.size()));
+        if (inserted) {
+            m_copyFunctions.push_back(TypeRegistry::getTypeDescriptor(typeHandle).copy);
+        }
+        return it->second;
+    };
+
+    m_steps.reserve(plan.steps.size());
+
+    // Walking the plan in order means the output feeding a connected input
+    // already has its lanes when the input is reached
+    for (const ExecutionStep& step : plan.steps) {
+        BatchStep batchStep;
+        batchStep.node = step.node;
+        batchStep.firstBinding = static_cast<uint32_t>(m_bindings.size());
+
+        std::vector<uint32_t> outputLanes;
+        batchStep.firstLane = static_cast<uint32_t>(m_stepLanes.size());
+
+        for (const auto& attribute : scene.getNodeAttributes(step.handle)) {
+            const AttributeHandle handle = attribute->getHandle();
+            const AttributeDescriptor& desc = attribute->getAttributeDescriptor();
+            const bool isOutput = desc.role == AttributeRole::eOutput;
+
+            // The last connection wins, as it does when the scene copies them
+            const auto& incoming = scene.getAttributeConnections(handle).incoming;
+            if (!incoming.empty() && m_laneIndex.contains(incoming.back().attributeSource)) {
+                m_laneIndex[handle] = m_laneIndex.at(incoming.back().attributeSource);
+            } else {
+                const uint32_t copyFunction = getCopyFunction(desc.typeHandle);
+                LaneArray lanes(desc.typeHandle, sampleCount);
+                for (size_t sample = 0; sample < sampleCount; ++sample) {
+                    m_copyFunctions[copyFunction](lanes.getLane(sample), attribute->getData());
+                }
+
+                m_laneIndex[handle] = static_cast<uint32_t>(m_lanes.size());
+                m_lanes.push_back(std::move(lanes));
+                m_isLaneUniform.push_back(!isOutput);
+                m_isLaneOutput.push_back(isOutput);
+                m_laneVersions.push_back(0);
+                m_laneCopyFunctions.push_back(copyFunction);
+            }
+
+            if (isOutput) {
+                outputLanes.push_back(m_laneIndex.at(handle));
+            } else {
+                m_stepLanes.push_back(m_laneIndex.at(handle));
+            }
+
+            if (!step.node->hasBatchCompute()) {
+                m_bindings.push_back(SampleBinding { getSlotIndex(handle), m_laneIndex.at(handle) });
+                m_sampleStorage.resize(std::max<size_t>(m_sampleStorage.size(), getSlotIndex(handle) + 1), nullptr);
+            }
+        }
+
+        batchStep.bindingCount = static_cast<uint32_t>(m_bindings.size()) - batchStep.firstBinding;
+        batchStep.inputLaneCount = static_cast<uint32_t>(m_stepLanes.size()) - batchStep.firstLane;
+        batchStep.outputLaneCount = static_cast<uint32_t>(outputLanes.size());
+        m_stepLanes.insert(m_stepLanes.end(), outputLanes.begin(), outputLanes.end());
+        m_steps.push_back(batchStep);
+    }
+
+    analyzeConstantSteps();
+}
+
+void SampleBatch::evaluate()
+{
+    for (BatchStep& step : m_steps) {
+        if (step.isConstant && isUpToDate(step)) {
+            continue;
+        }
+
+        // A constant node is computed for one sample and shared by the others,
+        // unless its batch compute handles every sample in one call anyway
+        if (step.node->hasBatchCompute()) {
+            Status status = step.node->computeBatch(*this);
+            if (status != Status::eOK) {
+                spdlog::error("Node '{}' batch computation failed with status: {}", step.node->getName(), static_cast<int>(status));
+            }
+        } else if (step.isConstant) {
+            computePerSample(step, std::min<size_t>(m_sampleCount, 1));
+            for (uint32_t i = 0; i < step.outputLaneCount; ++i) {
+                broadcastFirstSample(m_stepLanes[step.firstLane + step.inputLaneCount + i]);
+            }
+        } else {
+            computePerSample(step, m_sampleCount);
+        }
+
+        ++m_version;
+        for (uint32_t i = 0; i < step.outputLaneCount; ++i) {
+            m_laneVersions[m_stepLanes[step.firstLane + step.inputLaneCount + i]] = m_version;
+        }
+        step.computedVersion = step.isConstant ? m_version : 0;
+    }
+}
+
+size_t SampleBatch::getConstantNodeCount() const
+{
+    return static_cast<size_t>(std::ranges::count_if(m_steps, &BatchStep::isConstant));
+}
+
+uint32_t SampleBatch::findLanes(AttributeHandle handle, TypeHandle typeHandle) const
+{
+    auto it = m_laneIndex.find(handle);
+    if (it == m_laneIndex.end()) {
+        throw std::runtime_error("Attribute not part of SampleBatch: " + std::to_string(handle));
+    }
+    if (m_lanes[it->second].getTypeHandle() != typeHandle) {
+        throw std::runtime_error("Type mismatch in SampleBatch::getLanes");
+    }
+
+    return it->second;
+}
+
+void SampleBatch::onLanesExposed(uint32_t laneIndex)
+{
+    // Writes to an output are undone by computing its node again
+    if (m_isLaneOutput[laneIndex]) {
+        for (BatchStep& step : m_steps) {
+            const auto first = m_stepLanes.begin() + step.firstLane + step.inputLaneCount;
+            if (std::find(first, first + step.outputLaneCount, laneIndex) != first + step.outputLaneCount) {
+                step.computedVersion = 0;
+            }
+        }
+        return;
+    }
+
+    if (m_isLaneUniform[laneIndex]) {
+        m_isLaneUniform[laneIndex] = false;
+        analyzeConstantSteps();
+    }
+}
+
+void SampleBatch::analyzeConstantSteps()
+{
+    // Steps are in topological order, so every lane a step reads has been
+    // classified by the time the step is reached
+    for (BatchStep& step : m_steps) {
+        const auto first = m_stepLanes.begin() + step.firstLane;
+        step.isConstant = std::all_of(first, first + step.inputLaneCount, [this](uint32_t laneIndex) {
+            return m_isLaneUniform[laneIndex];
+        });
+        if (!step.isConstant) {
+            step.computedVersion = 0;
+        }
+
+        for (uint32_t i = 0; i < step.outputLaneCount; ++i) {
+            m_isLaneUniform[first[step.inputLaneCount + i]] = step.isConstant;
+        }
+    }
+}
+
+bool SampleBatch::isUpToDate(const BatchStep& step) const
+{
+    if (step.computedVersion == 0) {
+        return false;
+    }
+
+    const auto first = m_stepLanes.begin() + step.firstLane;
+    return std::all_of(first, first + step.inputLaneCount, [&](uint32_t laneIndex) {
+        return m_laneVersions[laneIndex] <= step.computedVersion;
+    });
+}
+
+void SampleBatch::broadcastFirstSample(uint32_t laneIndex)
+{
+    LaneArray& lanes = m_lanes[laneIndex];
+    const CopyFunc copy = m_copyFunctions[m_laneCopyFunctions[laneIndex]];
+    for (size_t sample = 1; sample < m_sampleCount; ++sample) {
+        copy(lanes.getLane(sample), lanes.getLane(0));
+    }
+}
+
+void SampleBatch::computePerSample(const BatchStep& step, size_t sampleCount)
+{
+    // The node's attributes, connected inputs included, read and write the
+    // sample's lanes directly, so nothing is copied in or out
+    AttributeStorageScope storage(m_sampleStorage);
+
+    // Writes to the outputs must not reach the scene as change notifications
+    std::vector<AttributeHandle> discardedChanges;
+    AttributeChangeCapture capture(discardedChanges);
+
+    for (size_t sample = 0; sample < sampleCount; ++sample) {
+        for (uint32_t i = step.firstBinding; i < step.firstBinding + step.bindingCount; ++i) {
+            const SampleBinding& binding = m_bindings[i];
+            m_sampleStorage[binding.slot] = m_lanes[binding.lanes].getLane(sample);
+        }
+
+        Status status = step.node->compute();
+        if (status != Status::eOK) {
+            spdlog::error("Node '{}' computation failed for sample {} with status: {}", step.node->getName(), sample, static_cast<int>(status));
+        }
+
+        discardedChanges.clear();
+    }
+}
+
+} // namespace cf::core
@@ -1,5 +1,946 @@
 #include "Scene.hpp"
+#include "Core/Events/NodeEvent.hpp"
 
 namespace cf::core {
 
-} // namespace cf::core
\ No newline at end of file
+EvaluationStatus Scene::evaluate()
+{
+    return evaluateDirty(EvaluationStopCondition {});
+}
+
+EvaluationStatus Scene::evaluate(const CancellationToken& token, std::optional<std::chrono::steady_clock::duration> budget)
+{
+    return evaluateDirty(EvaluationStopCondition { &token, budget });
+}
+
+EvaluationStatus Scene::evaluateOutputs(const std::vector<AttributeHandle>& outputs)
+{
+    return evaluateDirty(EvaluationStopCondition {}, &outputs);
+}
+
+void Scene::requestOutput(AttributeHandle handle)
+{
+    if (!m_attributes.contains(handle)) {
+        spdlog::error("Scene::requestOutput - Invalid attribute handle {}", handle);
+        return;
+    }
+
+    // A newly requested output is brought up to date as an edit would be
+    if (m_requestedOutputs[handle]++ == 0 && m_isDemandDriven && m_transactionDepth == 0 && m_evaluateOnChange) {
+        evaluate();
+    }
+}
+
+void Scene::releaseOutput(AttributeHandle handle)
+{
+    auto it = m_requestedOutputs.find(handle);
+    if (it == m_requestedOutputs.end()) {
+        spdlog::warn("Scene::releaseOutput - Attribute {} was not requested", handle);
+        return;
+    }
+
+    if (--it->second == 0) {
+        m_requestedOutputs.erase(it);
+    }
+}
+
+EvaluationStatus Scene::evaluateDirty(const EvaluationStopCondition& stopCondition, const std::vector<AttributeHandle>* outputs)
+{
+    if (m_isEvaluating || m_transactionDepth > 0)
+        return EvaluationStatus::eDeferred;
+    if (m_dirtyNodes.empty())
+        return EvaluationStatus::eComplete;
+
+    std::vector<AttributeHandle> requestedOutputs;
+    if (!outputs && m_isDemandDriven) {
+        requestedOutputs.reserve(m_requestedOutputs.size());
+        for (const auto& [handle, count] : m_requestedOutputs) {
+            requestedOutputs.push_back(handle);
+        }
+        outputs = &requestedOutputs;
+    }
+
+    const ExecutionPlan& plan = getExecutionPlan();
+
+    // Steps are stored in topological order
+    std::vector<uint32_t> dirtySteps;
+    if (outputs) {
+        collectDemandedSteps(plan, *outputs, dirtySteps);
+    } else {
+        dirtySteps.reserve(m_dirtyNodes.size());
+        for (NodeHandle handle : m_dirtyNodes) {
+            dirtySteps.push_back(plan.stepIndex.at(handle));
+        }
+    }
+    std::ranges::sort(dirtySteps);
+
+    if (dirtySteps.empty())
+        return EvaluationStatus::eComplete;
+    m_isEvaluating = true;
+
+    std::vector<uint32_t> completedSteps;
+    completedSteps.reserve(dirtySteps.size());
+    std::vector<AttributeHandle> changes;
+    std::exception_ptr failure;
+    EvaluationStatus status;
+
+    if (m_evaluationMode == EvaluationMode::eParallel && dirtySteps.size() > 1) {
+        status = evaluateParallel(plan, dirtySteps, stopCondition, completedSteps, changes, failure);
+    } else {
+        status = evaluateSerial(plan, dirtySteps, stopCondition, completedSteps, changes, failure);
+    }
+
+    // clear() would walk every bucket left over from the largest evaluation.
+    // A step is only skipped or failed after its upstream steps, so what stays
+    // dirty is still closed under "downstream of".
+    for (uint32_t stepIndex : completedSteps) {
+        m_dirtyNodes.erase(plan.steps[stepIndex].handle);
+    }
+
+    // Published while still evaluating, so they do not dirty the scene again
+    for (AttributeHandle handle : changes) {
+        EventBus::publish(AttributeEvent { AttributeEvent::AttributeMessage::eAttributeChanged, handle });
+    }
+
+    m_isEvaluating = false;
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    return status;
+}
+
+void Scene::beginTransaction()
+{
+    if (m_transactionDepth++ > 0) {
+        return;
+    }
+
+    m_transactionChanges.clear();
+    m_transactionCapture = std::make_unique<AttributeChangeCapture>(m_transactionChanges);
+    m_transactionRecorder = std::make_unique<AttributeEditRecorder>();
+}
+
+std::vector<AttributeEdit> Scene::commitTransaction()
+{
+    if (m_transactionDepth == 0) {
+        spdlog::warn("Scene::commitTransaction - No transaction in progress");
+        return {};
+    }
+    if (m_transactionDepth > 1) {
+        --m_transactionDepth;
+        return {};
+    }
+
+    // Transactions of other scenes on this thread may still be open, so
+    // these can be released out of creation order
+    std::vector<AttributeEdit> edits = m_transactionRecorder->takeEdits();
+    m_transactionRecorder.reset();
+    m_transactionCapture.reset();
+
+    // Every open recorder sees writes to every scene on this thread
+    std::erase_if(edits, [this](const AttributeEdit& edit) {
+        return getAttribute(edit.handle).get() != edit.attribute;
+    });
+
+    // Still inside the transaction, so these only mark nodes dirty. Writes
+    // made while another scene's transaction was opened later went to that
+    // transaction's capture, but they are all among the recorded edits.
+    std::unordered_set<AttributeHandle> published;
+    auto publish = [&published](AttributeHandle handle) {
+        if (published.insert(handle).second) {
+            EventBus::publish(AttributeEvent { AttributeEvent::AttributeMessage::eAttributeChanged, handle });
+        }
+    };
+    for (AttributeHandle handle : m_transactionChanges) {
+        publish(handle);
+    }
+    for (const AttributeEdit& edit : edits) {
+        publish(edit.handle);
+    }
+    m_transactionChanges.clear();
+
+    m_transactionDepth = 0;
+    if (m_evaluateOnChange) {
+        evaluate();
+    }
+
+    return edits;
+}
+
+const ExecutionPlan& Scene::getExecutionPlan()
+{
+    return *getSharedExecutionPlan();
+}
+
+std::shared_ptr<const ExecutionPlan> Scene::getSharedExecutionPlan()
+{
+    if (!m_isPlanValid) {
+        m_plan = std::make_shared<const ExecutionPlan>(ExecutionPlan::compile(*this));
+        m_pendingInputs = std::vector<std::atomic<uint32_t>>(m_plan->steps.size());
+        m_isStepScheduled.assign(m_plan->steps.size(), false);
+        m_isPlanValid = true;
+    }
+
+    return m_plan;
+}
+
+void Scene::runStep(const ExecutionPlan& plan, const ExecutionStep& step, std::vector<AttributeHandle>& changes)
+{
+    plan.collectLinkChanges(step, changes);
+
+    uint64_t inputHash = 0;
+    if (step.cache) {
+        inputHash = step.cache->hashInputs();
+        if (step.cache->restore(inputHash)) {
+            return;
+        }
+    }
+
+    Status status = step.node->compute();
+    if (status != Status::eOK) {
+        spdlog::error("Node '{}' computation failed with status: {}", step.node->getName(), static_cast<int>(status));
+    } else if (step.cache) {
+        step.cache->store(inputHash);
+    }
+}
+
+EvaluationStatus Scene::evaluateSerial(const ExecutionPlan& plan, const std::vector<uint32_t>& dirtySteps,
+    const EvaluationStopCondition& stopCondition, std::vector<uint32_t>& completedSteps, std::vector<AttributeHandle>& changes,
+    std::exception_ptr& failure)
+{
+    AttributeChangeCapture capture(changes);
+
+    for (uint32_t stepIndex : dirtySteps) {
+        const EvaluationStatus status = stopCondition.check(!completedSteps.empty());
+        if (status != EvaluationStatus::eComplete) {
+            return status;
+        }
+
+        try {
+            runStep(plan, plan.steps[stepIndex], changes);
+        } catch (...) {
+            failure = std::current_exception();
+            return EvaluationStatus::eComplete;
+        }
+        completedSteps.push_back(stepIndex);
+    }
+
+    return EvaluationStatus::eComplete;
+}
+
+EvaluationStatus Scene::evaluateParallel(const ExecutionPlan& plan, const std::vector<uint32_t>& dirtySteps,
+    const EvaluationStopCondition& stopCondition, std::vector<uint32_t>& completedSteps, std::vector<AttributeHandle>& changes,
+    std::exception_ptr& failure)
+{
+    ThreadPool& pool = m_threadPool ? *m_threadPool : ThreadPool::getInstance();
+
+    // Counting over the scheduled steps' successor lists counts exactly the
+    // scheduled inputs. Successors left out, e.g. by demand-driven
+    // evaluation, are neither counted nor run.
+    for (uint32_t stepIndex : dirtySteps) {
+        m_pendingInputs[stepIndex].store(0, std::memory_order_relaxed);
+        m_isStepScheduled[stepIndex] = true;
+    }
+    for (uint32_t stepIndex : dirtySteps) {
+        const ExecutionStep& step = plan.steps[stepIndex];
+        for (uint32_t i = step.firstSuccessor; i < step.firstSuccessor + step.successorCount; ++i) {
+            if (m_isStepScheduled[plan.successors[i]]) {
+                m_pendingInputs[plan.successors[i]].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::atomic<size_t> remaining { dirtySteps.size() };
+    std::mutex resultMutex;
+    EvaluationStatus status = EvaluationStatus::eComplete;
+    std::atomic<bool> isStopped { false };
+    std::atomic<bool> hasComputed { false };
+
+    std::function<void(uint32_t)> run = [&](uint32_t stepIndex) {
+        const ExecutionStep& step = plan.steps[stepIndex];
+
+        // Once stopped, every step still to start is skipped, which includes
+        // everything downstream of the steps skipped so far. A step that throws
+        // stops the evaluation too. Skipped steps still release their
+        // successors so that the counters drain.
+        bool isSkipped = isStopped.load(std::memory_order_acquire);
+        if (!isSkipped) {
+            const EvaluationStatus stopStatus = stopCondition.check(hasComputed.load(std::memory_order_relaxed));
+            if (stopStatus != EvaluationStatus::eComplete) {
+                std::lock_guard lock(resultMutex);
+                if (!isStopped.exchange(true, std::memory_order_acq_rel)) {
+                    status = stopStatus;
+                }
+                isSkipped = true;
+            }
+        }
+
+        if (!isSkipped) {
+            std::vector<AttributeHandle> localChanges;
+            std::exception_ptr stepFailure;
+            {
+                AttributeChangeCapture capture(localChanges);
+                try {
+                    runStep(plan, step, localChanges);
+                } catch (...) {
+                    stepFailure = std::current_exception();
+                }
+            }
+
+            std::lock_guard lock(resultMutex);
+            changes.insert(changes.end(), localChanges.begin(), localChanges.end());
+            if (stepFailure) {
+                // The failed step stays dirty, like the steps skipped after it
+                if (!failure) {
+                    failure = stepFailure;
+                }
+                isStopped.store(true, std::memory_order_release);
+            } else {
+                completedSteps.push_back(stepIndex);
+                hasComputed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        for (uint32_t i = step.firstSuccessor; i < step.firstSuccessor + step.successorCount; ++i) {
+            const uint32_t successor = plan.successors[i];
+            if (m_isStepScheduled[successor] && m_pendingInputs[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                pool.submit([&run, successor] { run(successor); });
+            }
+        }
+
+        remaining.fetch_sub(1, std::memory_order_release);
+    };
+
+    // Roots are collected up front: once the first task runs, counters of
+    // other steps may reach zero and those steps are submitted by their inputs
+    std::vector<uint32_t> roots;
+    for (uint32_t stepIndex : dirtySteps) {
+        if (m_pendingInputs[stepIndex].load(std::memory_order_relaxed) == 0) {
+            roots.push_back(stepIndex);
+        }
+    }
+
+    for (uint32_t root : roots) {
+        pool.submit([&run, root] { run(root); });
+    }
+
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!pool.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    for (uint32_t stepIndex : dirtySteps) {
+        m_isStepScheduled[stepIndex] = false;
+    }
+
+    return status;
+}
+
+NodeHandle Scene::insertNode(std::shared_ptr<Node> node, void* object, const NodeDescriptor& desc)
+{
+    releaseSlots();
+
+    const NodeHandle handle = m_nodes.insert(node);
+    node->m_handle = handle;
+    node->setName("Node " + std::to_string(getSlotIndex(handle) + 1));
+
+    const uint32_t nodeIndex = getSlotIndex(handle);
+    if (nodeIndex >= m_nodeAttributes.size()) {
+        m_nodeAttributes.resize(nodeIndex + 1);
+    }
+    m_nodeAttributes[nodeIndex].reserve(desc.attributes.size());
+
+    for (const auto& attrDesc : desc.attributes) {
+        auto attribute = createAttribute(attrDesc, handle);
+        if (attrDesc.setter) {
+            attrDesc.setter(object, attribute);
+        }
+    }
+
+    m_topologicalIndex[handle] = m_topologicalOrder.size();
+    m_topologicalOrder.push_back(handle);
+    m_isPlanValid = false;
+
+    if (auto it = m_resultCacheCapacities.find(desc.handle); it != m_resultCacheCapacities.end()) {
+        createResultCache(handle, it->second);
+    }
+
+    // Nothing is connected to a new node yet, so nothing downstream to mark
+    m_dirtyNodes.insert(handle);
+
+    return handle;
+}
+
+void Scene::reserveNodes(size_t count, size_t attributesPerNode)
+{
+    const size_t nodeCount = m_nodes.getSlotCount() + count;
+    const size_t attributeCount = m_attributes.getSlotCount() + count * attributesPerNode;
+
+    m_nodes.reserve(nodeCount);
+    m_nodeAttributes.reserve(nodeCount);
+    m_topologicalOrder.reserve(nodeCount);
+    m_topologicalIndex.reserve(nodeCount);
+    m_dirtyNodes.reserve(m_dirtyNodes.size() + count);
+
+    m_attributes.reserve(attributeCount);
+    m_attributeNodes.reserve(attributeCount);
+}
+
+bool Scene::enableResultCache(NodeDescriptorHandle nodeType, size_t capacity)
+{
+    bool isCacheable = true;
+    for (const auto& [handle, node] : m_nodes) {
+        if (node->getType() == nodeType) {
+            isCacheable = createResultCache(handle, capacity) && isCacheable;
+        }
+    }
+
+    if (capacity == 0 || !isCacheable) {
+        m_resultCacheCapacities.erase(nodeType);
+    } else {
+        m_resultCacheCapacities[nodeType] = capacity;
+    }
+
+    m_isPlanValid = false;
+    return isCacheable;
+}
+
+void Scene::collectDemandedSteps(const ExecutionPlan& plan, const std::vector<AttributeHandle>& outputs, std::vector<uint32_t>& steps) const
+{
+    // The upstream of a clean node is clean, so the walk only needs to
+    // follow dirty nodes
+    std::unordered_set<NodeHandle> visited;
+    std::vector<NodeHandle> pending;
+    for (AttributeHandle handle : outputs) {
+        const NodeHandle nodeHandle = getAttributeNode(handle);
+        if (m_dirtyNodes.contains(nodeHandle)) {
+            pending.push_back(nodeHandle);
+        }
+    }
+
+    while (!pending.empty()) {
+        const NodeHandle current = pending.back();
+        pending.pop_back();
+        if (!visited.insert(current).second) {
+            continue;
+        }
+
+        steps.push_back(plan.stepIndex.at(current));
+        forEachPredecessor(current, [&](NodeHandle predecessor) {
+            if (m_dirtyNodes.contains(predecessor)) {
+                pending.push_back(predecessor);
+            }
+        });
+    }
+}
+
+ResultCache* Scene::findResultCache(NodeHandle handle) const
+{
+    auto it = m_resultCaches.find(handle);
+    return it != m_resultCaches.end() ? it->second.get() : nullptr;
+}
+
+ResultCacheStats Scene::getResultCacheStats() const
+{
+    ResultCacheStats total;
+    for (const auto& [handle, cache] : m_resultCaches) {
+        total.hits += cache->getStats().hits;
+        total.misses += cache->getStats().misses;
+    }
+
+    return total;
+}
+
+bool Scene::createResultCache(NodeHandle handle, size_t capacity)
+{
+    m_resultCaches.erase(handle);
+    if (capacity == 0) {
+        return true;
+    }
+
+    // Descriptor order keeps the inputs in a stable order for hashing
+    std::vector<Attribute*> inputs;
+    std::vector<Attribute*> outputs;
+    for (const auto& attribute : getNodeAttributes(handle)) {
+        if (attribute->getAttributeDescriptor().role == AttributeRole::eOutput) {
+            outputs.push_back(attribute.get());
+        } else {
+            inputs.push_back(attribute.get());
+        }
+    }
+
+    if (!ResultCache::canHash(inputs)) {
+        spdlog::warn("Scene::enableResultCache - Node '{}' has inputs without a hash or equality, it is not cached",
+            getNode(handle)->getName());
+        return false;
+    }
+
+    m_resultCaches[handle] = std::make_unique<ResultCache>(std::move(inputs), std::move(outputs), capacity);
+    return true;
+}
+
+bool Scene::markDirty(AttributeHandle attributeHandle)
+{
+    const NodeHandle nodeHandle = getAttributeNode(attributeHandle);
+    if (nodeHandle == kInvalidNodeHandle) {
+        return false;
+    }
+
+    markNodeDirty(nodeHandle);
+    return true;
+}
+
+void Scene::markNodeDirty(NodeHandle nodeHandle)
+{
+    std::vector<NodeHandle> pending { nodeHandle };
+    while (!pending.empty()) {
+        NodeHandle current = pending.back();
+        pending.pop_back();
+
+        // An already dirty node has its downstream dirty as well
+        if (!m_dirtyNodes.insert(current).second) {
+            continue;
+        }
+
+        forEachSuccessor(current, [&pending](NodeHandle successor) {
+            pending.push_back(successor);
+        });
+    }
+}
+
+namespace {
+
+// Order is only kept where it matters, for the sources of an input
+void eraseConnection(std::vector<Connection>& list, AttributeHandle fromAttr, AttributeHandle toAttr, bool keepOrder = false)
+{
+    auto it = std::ranges::find_if(list, [fromAttr, toAttr](const Connection& conn) {
+        return conn.attributeSource == fromAttr && conn.attributeTarget == toAttr;
+    });
+
+    if (it == list.end()) {
+        return;
+    }
+
+    if (keepOrder) {
+        list.erase(it);
+    } else {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+} // namespace
+
+void Scene::removeConnection(AttributeHandle fromAttr, AttributeHandle toAttr)
+{
+    auto indexIt = m_connectionIndex.find({ fromAttr, toAttr });
+    if (indexIt == m_connectionIndex.end()) {
+        return;
+    }
+
+    const size_t index = indexIt->second;
+    const Connection removed = connections[index];
+    m_connectionIndex.erase(indexIt);
+
+    // Swap the last connection into the freed slot
+    if (index != connections.size() - 1) {
+        connections[index] = connections.back();
+        m_connectionIndex[{ connections[index].attributeSource, connections[index].attributeTarget }] = index;
+    }
+    connections.pop_back();
+    m_isPlanValid = false;
+
+    eraseConnection(m_nodeConnections[removed.nodeSource].outgoing, fromAttr, toAttr);
+    eraseConnection(m_nodeConnections[removed.nodeTarget].incoming, fromAttr, toAttr);
+    eraseConnection(m_attributeConnections[fromAttr].outgoing, fromAttr, toAttr);
+    eraseConnection(m_attributeConnections[toAttr].incoming, fromAttr, toAttr, true);
+
+    // The most recent connection into an input is the one it reads, so only
+    // removing that one changes the source
+    auto target = getAttribute(toAttr);
+    auto source = getAttribute(fromAttr);
+    if (target && target->getSource() == source.get()) {
+        const auto& remaining = m_attributeConnections[toAttr].incoming;
+        target->setSource(remaining.empty() ? nullptr : getAttribute(remaining.back().attributeSource).get());
+    }
+
+    markNodeDirty(removed.nodeTarget);
+}
+
+RemovedNodes Scene::removeNodes(std::span<const NodeHandle> handles)
+{
+    RemovedNodes removed;
+    if (m_isEvaluating) {
+        spdlog::error("Scene::removeNodes - Nodes cannot be removed during evaluation");
+        return removed;
+    }
+
+    std::vector<NodeHandle> nodeHandles;
+    std::unordered_set<NodeHandle> removing;
+    for (NodeHandle handle : handles) {
+        if (m_nodes.contains(handle) && removing.insert(handle).second) {
+            nodeHandles.push_back(handle);
+        }
+    }
+    if (nodeHandles.empty()) {
+        return removed;
+    }
+
+    // A connection between two removed nodes is only listed as outgoing
+    for (NodeHandle handle : nodeHandles) {
+        const ConnectionList& nodeConnections = getNodeConnections(handle);
+        removed.connections.insert(removed.connections.end(), nodeConnections.outgoing.begin(), nodeConnections.outgoing.end());
+        for (const Connection& conn : nodeConnections.incoming) {
+            if (!removing.contains(conn.nodeSource)) {
+                removed.connections.push_back(conn);
+            }
+        }
+    }
+
+    // Disconnected inputs copy the value they read while it is still stored
+    for (const Connection& conn : removed.connections) {
+        removeConnection(conn.attributeSource, conn.attributeTarget);
+    }
+
+    removed.nodes.reserve(nodeHandles.size());
+    for (NodeHandle handle : nodeHandles) {
+        eraseNode(handle, removed);
+    }
+    reserveSlots(removed);
+
+    m_isPlanValid = false;
+    if (m_topologicalGaps > m_nodes.size()) {
+        compactTopologicalOrder();
+    }
+
+    std::vector<std::pair<AttributeHandle, AttributeHandle>> connectionHandles;
+    connectionHandles.reserve(removed.connections.size());
+    for (const Connection& conn : removed.connections) {
+        connectionHandles.emplace_back(conn.attributeSource, conn.attributeTarget);
+    }
+    EventBus::publish(NodeEvent { NodeEvent::NodeMessage::eNodesRemoved, std::move(nodeHandles), std::move(connectionHandles) });
+
+    return removed;
+}
+
+void Scene::reserveSlots(RemovedNodes& removed)
+{
+    auto released = std::make_shared<ReleasedSlots>();
+    for (const auto& entry : removed.nodes) {
+        released->nodes.push_back(entry.handle);
+        for (const auto& attribute : entry.attributes) {
+            released->attributes.push_back(attribute->getHandle());
+        }
+    }
+
+    // The deleter runs once the last copy of `removed` is dropped
+    removed.slotReservation = std::shared_ptr<void>(nullptr, [target = m_releasedSlots, released](void*) {
+        target->nodes.insert(target->nodes.end(), released->nodes.begin(), released->nodes.end());
+        target->attributes.insert(target->attributes.end(), released->attributes.begin(), released->attributes.end());
+    });
+}
+
+void Scene::releaseSlots()
+{
+    for (NodeHandle handle : m_releasedSlots->nodes) {
+        m_nodes.releaseSlot(handle);
+    }
+    for (AttributeHandle handle : m_releasedSlots->attributes) {
+        m_attributes.releaseSlot(handle);
+    }
+
+    m_releasedSlots->nodes.clear();
+    m_releasedSlots->attributes.clear();
+}
+
+void Scene::eraseNode(NodeHandle handle, RemovedNodes& removed)
+{
+    const uint32_t nodeIndex = getSlotIndex(handle);
+    RemovedNodes::Entry entry { handle, *m_nodes.find(handle), std::move(m_nodeAttributes[nodeIndex]) };
+    m_nodeAttributes[nodeIndex].clear();
+
+    for (const auto& attribute : entry.attributes) {
+        const AttributeHandle attrHandle = attribute->getHandle();
+        if (auto it = m_requestedOutputs.find(attrHandle); it != m_requestedOutputs.end()) {
+            removed.requestedOutputs.emplace_back(it->first, it->second);
+            m_requestedOutputs.erase(it);
+        }
+
+        // The attribute keeps its value for as long as it is held elsewhere
+        if (void* storage = attribute->detachStorage()) {
+            m_attributeStorage.release(attribute->getTypeHandle(), storage);
+        }
+
+        m_attributeConnections.erase(attrHandle);
+        m_attributeNodes[getSlotIndex(attrHandle)] = kInvalidNodeHandle;
+        m_attributes.retainSlot(attrHandle); // Released by the slot reservation of `removed`
+        m_attributes.erase(attrHandle);
+    }
+
+    m_nodeConnections.erase(handle);
+    m_resultCaches.erase(handle);
+    m_dirtyNodes.erase(handle);
+
+    m_topologicalOrder[m_topologicalIndex.at(handle)] = kInvalidNodeHandle;
+    m_topologicalIndex.erase(handle);
+    ++m_topologicalGaps;
+
+    entry.node->m_handle = kInvalidNodeHandle;
+    m_nodes.retainSlot(handle);
+    m_nodes.erase(handle);
+    removed.nodes.push_back(std::move(entry));
+}
+
+bool Scene::restoreNodes(const RemovedNodes& removed)
+{
+    if (m_isEvaluating) {
+        spdlog::error("Scene::restoreNodes - Nodes cannot be restored during evaluation");
+        return false;
+    }
+
+    for (const auto& entry : removed.nodes) {
+        bool canRestore = m_nodes.canRestore(entry.handle);
+        for (const auto& attribute : entry.attributes) {
+            canRestore = canRestore && m_attributes.canRestore(attribute->getHandle());
+        }
+
+        if (!canRestore) {
+            spdlog::error("Scene::restoreNodes - Node '{}' cannot be restored, it is not a removed node of this scene", entry.node->getName());
+            return false;
+        }
+    }
+
+    std::vector<NodeHandle> nodeHandles;
+    nodeHandles.reserve(removed.nodes.size());
+    for (const auto& entry : removed.nodes) {
+        m_nodes.restore(entry.handle, entry.node);
+        entry.node->m_handle = entry.handle;
+        m_nodeAttributes[getSlotIndex(entry.handle)] = entry.attributes;
+
+        for (const auto& attribute : entry.attributes) {
+            m_attributes.restore(attribute->getHandle(), attribute);
+            attribute->attachStorage(m_attributeStorage.allocate(attribute->getTypeHandle()));
+            m_attributeNodes[getSlotIndex(attribute->getHandle())] = entry.handle;
+        }
+
+        // Restored connections move the node to its place in the order
+        m_topologicalIndex[entry.handle] = m_topologicalOrder.size();
+        m_topologicalOrder.push_back(entry.handle);
+
+        if (auto it = m_resultCacheCapacities.find(entry.node->getType()); it != m_resultCacheCapacities.end()) {
+            createResultCache(entry.handle, it->second);
+        }
+
+        m_dirtyNodes.insert(entry.handle);
+        nodeHandles.push_back(entry.handle);
+    }
+
+    for (const auto& [handle, count] : removed.requestedOutputs) {
+        m_requestedOutputs[handle] += count;
+    }
+
+    // Nodes on the other end may have been removed since
+    std::vector<std::pair<AttributeHandle, AttributeHandle>> connectionHandles;
+    for (const Connection& conn : removed.connections) {
+        if (m_nodes.contains(conn.nodeSource) && m_nodes.contains(conn.nodeTarget) && insertConnection(conn)) {
+            connectionHandles.emplace_back(conn.attributeSource, conn.attributeTarget);
+        }
+    }
+
+    m_isPlanValid = false;
+    EventBus::publish(NodeEvent { NodeEvent::NodeMessage::eNodesRestored, std::move(nodeHandles), std::move(connectionHandles) });
+
+    return true;
+}
+
+void Scene::compactTopologicalOrder() const
+{
+    if (m_topologicalGaps == 0) {
+        return;
+    }
+
+    size_t position = 0;
+    for (size_t i = 0; i < m_topologicalOrder.size(); ++i) {
+        const NodeHandle handle = m_topologicalOrder[i];
+        if (handle != kInvalidNodeHandle) {
+            m_topologicalOrder[position] = handle;
+            m_topologicalIndex[handle] = position++;
+        }
+    }
+
+    m_topologicalOrder.resize(position);
+    m_topologicalGaps = 0;
+}
+
+const ConnectionList& Scene::getNodeConnections(NodeHandle handle) const
+{
+    static const ConnectionList kEmpty;
+
+    auto it = m_nodeConnections.find(handle);
+    return it != m_nodeConnections.end() ? it->second : kEmpty;
+}
+
+const ConnectionList& Scene::getAttributeConnections(AttributeHandle handle) const
+{
+    static const ConnectionList kEmpty;
+
+    auto it = m_attributeConnections.find(handle);
+    return it != m_attributeConnections.end() ? it->second : kEmpty;
+}
+
+bool Scene::insertConnection(const Connection& connection)
+{
+    // Also rejects nodes and attributes of another scene, or an attribute
+    // paired with a node it does not belong to
+    if (!m_nodes.contains(connection.nodeSource) || !m_nodes.contains(connection.nodeTarget)
+        || getAttributeNode(connection.attributeSource) != connection.nodeSource
+        || getAttributeNode(connection.attributeTarget) != connection.nodeTarget) {
+        spdlog::error("Scene::insertConnection - Invalid node or attribute handle(s) provided");
+        return false;
+    }
+
+    // Connected inputs read their source's storage as their own type, so the
+    // types must match exactly
+    const Attribute& source = **m_attributes.find(connection.attributeSource);
+    const Attribute& target = **m_attributes.find(connection.attributeTarget);
+    if (source.getAttributeDescriptor().role == AttributeRole::eInput
+        || target.getAttributeDescriptor().role == AttributeRole::eOutput) {
+        spdlog::error("Scene::insertConnection - Attribute {} cannot feed attribute {}, connections go from an output to an input",
+            connection.attributeSource, connection.attributeTarget);
+        return false;
+    }
+    if (source.getTypeHandle() != target.getTypeHandle()) {
+        spdlog::error("Scene::insertConnection - Type mismatch between attributes {} and {}",
+            connection.attributeSource, connection.attributeTarget);
+        return false;
+    }
+
+    if (m_connectionIndex.contains({ connection.attributeSource, connection.attributeTarget })) {
+        spdlog::warn("Scene::insertConnection - Attributes {} and {} are already connected",
+            connection.attributeSource, connection.attributeTarget);
+        return false;
+    }
+
+    if (!reorderForConnection(connection.nodeSource, connection.nodeTarget)) {
+        spdlog::error("Scene::insertConnection - Connection from node {} to node {} would create a cycle",
+            connection.nodeSource, connection.nodeTarget);
+        return false;
+    }
+
+    m_connectionIndex[{ connection.attributeSource, connection.attributeTarget }] = connections.size();
+    connections.push_back(connection);
+    m_isPlanValid = false;
+
+    m_nodeConnections[connection.nodeSource].outgoing.push_back(connection);
+    m_nodeConnections[connection.nodeTarget].incoming.push_back(connection);
+    m_attributeConnections[connection.attributeSource].outgoing.push_back(connection);
+    m_attributeConnections[connection.attributeTarget].incoming.push_back(connection);
+
+    // Connected inputs read the output directly; the last connection wins
+    (*m_attributes.find(connection.attributeTarget))->setSource(&source);
+
+    markNodeDirty(connection.nodeTarget);
+    return true;
+}
+
+/**
+ * Pearce-Kelly dynamic topological ordering. Only the nodes between the target
+ * and the source in the current order can be affected by the new edge: the
+ * target's descendants and the source's ancestors inside that window are
+ * collected and redistributed over the positions they already occupy, with
+ * the ancestors first.
+ */
+bool Scene::reorderForConnection(NodeHandle source, NodeHandle target)
+{
+    if (source == target) {
+        return false;
+    }
+
+    const size_t lowerBound = m_topologicalIndex.at(target);
+    const size_t upperBound = m_topologicalIndex.at(source);
+    if (upperBound < lowerBound) {
+        return true;
+    }
+
+    std::vector<NodeHandle> forward;
+    std::unordered_set<NodeHandle> visited { target };
+    std::vector<NodeHandle> pending { target };
+    bool createsCycle = false;
+
+    while (!pending.empty() && !createsCycle) {
+        NodeHandle current = pending.back();
+        pending.pop_back();
+        forward.push_back(current);
+
+        forEachSuccessor(current, [&](NodeHandle successor) {
+            if (successor == source) {
+                createsCycle = true;
+            } else if (m_topologicalIndex.at(successor) < upperBound && visited.insert(successor).second) {
+                pending.push_back(successor);
+            }
+        });
+    }
+
+    if (createsCycle) {
+        return false;
+    }
+
+    std::vector<NodeHandle> backward;
+    visited = { source };
+    pending = { source };
+
+    while (!pending.empty()) {
+        NodeHandle current = pending.back();
+        pending.pop_back();
+        backward.push_back(current);
+
+        forEachPredecessor(current, [&](NodeHandle predecessor) {
+            if (m_topologicalIndex.at(predecessor) > lowerBound && visited.insert(predecessor).second) {
+                pending.push_back(predecessor);
+            }
+        });
+    }
+
+    auto byIndex = [this](NodeHandle handle) { return m_topologicalIndex.at(handle); };
+    std::ranges::sort(forward, {}, byIndex);
+    std::ranges::sort(backward, {}, byIndex);
+
+    std::vector<size_t> slots;
+    slots.reserve(forward.size() + backward.size());
+    for (NodeHandle handle : backward) {
+        slots.push_back(m_topologicalIndex.at(handle));
+    }
+    for (NodeHandle handle : forward) {
+        slots.push_back(m_topologicalIndex.at(handle));
+    }
+    std::ranges::sort(slots);
+
+    size_t slot = 0;
+    for (const auto* affected : { &backward, &forward }) {
+        for (NodeHandle handle : *affected) {
+            m_topologicalOrder[slots[slot]] = handle;
+            m_topologicalIndex[handle] = slots[slot];
+            ++slot;
+        }
+    }
+
+    return true;
+}
+
+void Scene::onAttributeChanged(AttributeHandle attributeHandle)
+{
+    // Writes made by the evaluation itself only touch nodes that are already
+    // scheduled, so they must not re-enter it
+    if (m_isEvaluating) {
+        return;
+    }
+
+    if (markDirty(attributeHandle) && m_transactionDepth == 0 && m_evaluateOnChange) {
+        evaluate();
+    }
+}
+
+} // namespace cf::core
@@ -0,0 +1,42 @@
+#include "SceneTransaction.hpp"
+#include "Commands/SetAttributesCommand.hpp"
+
+namespace cf::core {
+
+SceneTransaction::SceneTransaction(Scene& scene)
+    : m_scene(scene)
+{
+    m_scene.beginTransaction();
+}
+
+SceneTransaction::SceneTransaction(std::shared_ptr<Scene> scene, UndoStack& undoStack)
+    : m_scene(*scene)
+    , m_sharedScene(std::move(scene))
+    , m_undoStack(&undoStack)
+{
+    m_scene.beginTransaction();
+}
+
+SceneTransaction::~SceneTransaction()
+{
+    try {
+        commit();
+    } catch (const std::exception& e) {
+        spdlog::error("SceneTransaction - Commit failed: {}", e.what());
+    }
+}
+
+void SceneTransaction::commit()
+{
+    if (!m_isOpen) {
+        return;
+    }
+    m_isOpen = false;
+
+    std::vector<AttributeEdit> edits = m_scene.commitTransaction();
+    if (m_undoStack && !edits.empty()) {
+        m_undoStack->push(std::make_unique<SetAttributesCommand>(m_sharedScene, std::move(edits)));
+    }
+}
+
+} // namespace cf::core
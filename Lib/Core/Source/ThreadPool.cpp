@@ -0,0 +1,132 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace cf::core {
+
+namespace {
+
+// Identifies the pool and queue owned by the current thread, if it is a worker
+thread_local const ThreadPool* t_workerPool = nullptr;
+thread_local size_t t_workerIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    threadCount = std::max<size_t>(threadCount, 1);
+
+    m_queues.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    const size_t index = (t_workerPool == this)
+        ? t_workerIndex
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    {
+        std::lock_guard lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        // Taking the sleep mutex orders the increment against a worker that is
+        // about to check the predicate and go to sleep
+        std::lock_guard lock(m_sleepMutex);
+        m_pendingTasks.fetch_add(1, std::memory_order_release);
+    }
+    m_wakeUp.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    Task task;
+    const bool isWorker = (t_workerPool == this);
+
+    if ((isWorker && tryPop(t_workerIndex, task)) || trySteal(isWorker ? t_workerIndex : m_queues.size(), task)) {
+        m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    t_workerPool = this;
+    t_workerIndex = index;
+
+    while (true) {
+        if (runPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_wakeUp.wait(lock, [this] {
+            return m_stopping || m_pendingTasks.load(std::memory_order_acquire) > 0;
+        });
+
+        if (m_stopping && m_pendingTasks.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::tryPop(size_t index, Task& task)
+{
+    auto& queue = *m_queues[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::trySteal(size_t thiefIndex, Task& task)
+{
+    const size_t queueCount = m_queues.size();
+    for (size_t offset = 1; offset <= queueCount; ++offset) {
+        const size_t victim = (thiefIndex + offset) % queueCount;
+        if (victim == thiefIndex) {
+            continue;
+        }
+
+        auto& queue = *m_queues[victim];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace cf::core
@@ -4,12 +4,15 @@ namespace cf::core {
 
 void UndoStack::push(std::unique_ptr<Command> command)
 {
+    command->execute();
+    if (!command->hasEffect()) {
+        return;
+    }
+
     while (!m_redoStack.empty()) {
         m_redoStack.pop();
     }
 
-    command->execute();
-
     m_undoStack.push(std::move(command));
 }
 
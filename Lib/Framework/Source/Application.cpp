@@ -3,7 +3,12 @@
 #include "Core/DataTypes.hpp"
 #include "Core/Events/AttributeEvent.hpp"
 #include "Core/Events/ConnectionAddedEvent.hpp"
+#include "Core/Events/NodeEvent.hpp"
 #include "Core/Nodes/AddNode.hpp"
+#include "Core/Nodes/ComposeTransformNode.hpp"
+#include "Core/Nodes/MultiplyMatrixNode.hpp"
+#include "Core/Nodes/RotateVectorNode.hpp"
+#include "Core/Nodes/TransformPointNode.hpp"
 #include <spdlog/spdlog.h>
 
 namespace cf::framework {
@@ -27,11 +32,29 @@ void registerTypes()
     core::TypeRegistry::registerType<core::Double>();
 
     core::TypeRegistry::registerType<core::String>();
+
+    core::TypeRegistry::registerType<core::FloatArray>();
+    core::TypeRegistry::registerType<core::DoubleArray>();
+    core::TypeRegistry::registerType<core::Int32Array>();
+    core::TypeRegistry::registerType<core::SharedFloatArray>();
+    core::TypeRegistry::registerType<core::SharedDoubleArray>();
+    core::TypeRegistry::registerType<core::SharedInt32Array>();
+
+    core::TypeRegistry::registerType<core::Vec2>();
+    core::TypeRegistry::registerType<core::Vec3>();
+    core::TypeRegistry::registerType<core::Vec4>();
+    core::TypeRegistry::registerType<core::Quat>();
+    core::TypeRegistry::registerType<core::Mat3>();
+    core::TypeRegistry::registerType<core::Mat4>();
 }
 
 void registerNodeTypes()
 {
     core::TypeRegistry::registerNodeType<core::AddNode>();
+    core::TypeRegistry::registerNodeType<core::ComposeTransformNode>();
+    core::TypeRegistry::registerNodeType<core::MultiplyMatrixNode>();
+    core::TypeRegistry::registerNodeType<core::RotateVectorNode>();
+    core::TypeRegistry::registerNodeType<core::TransformPointNode>();
 }
 
 void registerEventTypes()
@@ -39,6 +62,7 @@ void registerEventTypes()
     core::TypeRegistry::registerEventType<core::AttributeEvent>("AttributeEvent", "Attribute");
     core::TypeRegistry::registerEventType<core::ConnectionAddedEvent>("ConnectionAddedEvent", "Connection");
     core::TypeRegistry::registerEventType<core::ConnectionRemovedEvent>("ConnectionRemovedEvent", "Connection");
+    core::TypeRegistry::registerEventType<core::NodeEvent>("NodeEvent", "Node");
 }
 
 int Application::run()
@@ -9,10 +9,14 @@
 
 namespace cf::ui {
 
+class QtApplicationContext;
+
 class QtAttribute : public QObject {
     Q_OBJECT
 public:
-    explicit QtAttribute(std::shared_ptr<core::Attribute> attribute, QObject* parent = nullptr);
+    explicit QtAttribute(std::shared_ptr<core::Attribute> attribute,
+        QtApplicationContext& appContext,
+        QObject* parent = nullptr);
 
     ~QtAttribute() override;
 
@@ -33,7 +37,12 @@ signals:
     void valueChanged();
 
 private:
+    // Reads from the latest evaluation snapshot when evaluation is asynchronous
+    template <typename Type>
+    Type readValue() const;
+
     std::shared_ptr<core::Attribute> m_attribute;
+    QtApplicationContext& m_appContext;
     core::EventBus::SubscriptionId m_eventSubscriptionId { core::EventBus::kInvalidSubscriptionId };
 };
 
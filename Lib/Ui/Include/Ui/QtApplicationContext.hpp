@@ -1,6 +1,7 @@
 #ifndef CF_UI_QTAPPLICATIONCONTEXT_HPP
 #define CF_UI_QTAPPLICATIONCONTEXT_HPP
 
+#include "Core/AsyncEvaluator.hpp"
 #include "Core/Events/ConnectionAddedEvent.hpp"
 #include "Framework/ApplicationContext.hpp"
 #include "Ui/SelectionManager.hpp"
@@ -20,6 +21,16 @@ public:
 
     void setupEventSubscriptions();
 
+    /**
+     * @brief Moves evaluation of the active scene to a background thread.
+     * Results are then read from getEvaluationSnapshot, which is replaced on
+     * this thread once per completed evaluation.
+     */
+    void enableAsyncEvaluation();
+    bool isAsyncEvaluationEnabled() const { return m_asyncEvaluator != nullptr; }
+
+    std::shared_ptr<const core::EvaluationSnapshot> getEvaluationSnapshot() const { return m_evaluationSnapshot; }
+
     std::shared_ptr<core::Document> getCurrentDocument() const
     {
         return m_appContext.getCurrentDocument();
@@ -50,11 +61,17 @@ public:
 
 signals:
     void connectionAdded(const core::ConnectionAddedEvent& event);
+    void evaluationCompleted(const std::shared_ptr<const core::EvaluationSnapshot>& snapshot);
 
 private:
     framework::ApplicationContext& m_appContext;
     std::vector<core::EventBus::SubscriptionId> m_subscriptions;
     SelectionManager m_selectionManager;
+
+    // The evaluator is declared last so it stops before the scene it uses is released
+    std::shared_ptr<core::Scene> m_evaluatedScene;
+    std::shared_ptr<const core::EvaluationSnapshot> m_evaluationSnapshot;
+    std::unique_ptr<core::AsyncEvaluator> m_asyncEvaluator;
 };
 
 } // namespace cf::ui
@@ -11,6 +11,7 @@ GuiManager::GuiManager(framework::ApplicationContext& appContext)
 
 void GuiManager::show()
 {
+    m_qtAppContext.enableAsyncEvaluation();
     m_mainWindow.show();
 }
 
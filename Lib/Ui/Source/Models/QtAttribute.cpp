@@ -1,21 +1,39 @@
 #include "Models/QtAttribute.hpp"
 #include "Core/EventBus.hpp"
 #include "Core/Events/AttributeEvent.hpp"
+#include "Ui/QtApplicationContext.hpp"
 #include "spdlog/spdlog.h"
 
+#include <algorithm>
+
 namespace cf::ui {
 
-QtAttribute::QtAttribute(std::shared_ptr<core::Attribute> attribute, QObject* parent)
+QtAttribute::QtAttribute(std::shared_ptr<core::Attribute> attribute,
+    QtApplicationContext& appContext,
+    QObject* parent)
     : QObject(parent)
     , m_attribute(attribute)
+    , m_appContext(appContext)
 {
     m_eventSubscriptionId = core::EventBus::subscribe<core::AttributeEvent>([this](const core::AttributeEvent& event) {
+        // Asynchronous results are announced by evaluationCompleted instead
+        if (m_appContext.isAsyncEvaluationEnabled()) {
+            return;
+        }
+
         if (event.m_message == core::AttributeEvent::AttributeMessage::eAttributeChanged) {
             if (event.attributeHandle == m_attribute->getHandle()) {
                 emit valueChanged();
             }
         }
     });
+
+    connect(&m_appContext, &QtApplicationContext::evaluationCompleted, this,
+        [this](const std::shared_ptr<const core::EvaluationSnapshot>& snapshot) {
+            if (std::ranges::binary_search(snapshot->getChangedAttributes(), m_attribute->getHandle())) {
+                emit valueChanged();
+            }
+        });
 }
 
 QtAttribute::~QtAttribute()
@@ -64,31 +82,42 @@ QVariant QtAttribute::getValue() const
     if (typeHandle == core::TypeRegistry::getTypeHandle<int>()) {
         spdlog::debug("QtAttribute::getValue() - Attribute '{}' is of type int with value {}",
             getName().toStdString(),
-            m_attribute->getValue<int>());
+            readValue<int>());
 
-        return QVariant(m_attribute->getValue<int>());
+        return QVariant(readValue<int>());
 
     } else if (typeHandle == core::TypeRegistry::getTypeHandle<float>()) {
         spdlog::debug("QtAttribute::getValue() - Attribute '{}' is of type float with value {}",
             getName().toStdString(),
-            m_attribute->getValue<float>());
-        return QVariant(m_attribute->getValue<float>());
+            readValue<float>());
+        return QVariant(readValue<float>());
 
     } else if (typeHandle == core::TypeRegistry::getTypeHandle<double>()) {
         spdlog::debug("QtAttribute::getValue() - Attribute '{}' is of type double with value {}",
             getName().toStdString(),
-            m_attribute->getValue<double>());
-        return QVariant(m_attribute->getValue<double>());
+            readValue<double>());
+        return QVariant(readValue<double>());
 
     } else if (typeHandle == core::TypeRegistry::getTypeHandle<std::string>()) {
         spdlog::debug("QtAttribute::getValue() - Attribute '{}' is of type std::string with value {}",
             getName().toStdString(),
-            m_attribute->getValue<std::string>());
+            readValue<std::string>());
 
-        return QString::fromStdString(m_attribute->getValue<std::string>());
+        return QString::fromStdString(readValue<std::string>());
     }
     // Add more types as needed
     return QVariant();
 }
 
+template <typename Type>
+Type QtAttribute::readValue() const
+{
+    auto snapshot = m_appContext.getEvaluationSnapshot();
+    if (snapshot && snapshot->contains(m_attribute->getHandle())) {
+        return snapshot->getValue<Type>(m_attribute->getHandle());
+    }
+
+    return m_attribute->getValue<Type>();
+}
+
 } // namespace cf::ui
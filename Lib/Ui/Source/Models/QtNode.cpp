@@ -28,7 +28,7 @@ void QtNode::loadAttributes()
 {
     auto attributes = m_appContext.getActiveScene()->getNodeAttributes(m_node);
     for (const auto& attr : attributes) {
-        auto qtAttr = new QtAttribute(attr, this);
+        auto qtAttr = new QtAttribute(attr, m_appContext, this);
         m_attributes.append(qtAttr);
     }
 }
@@ -128,10 +128,10 @@ void NodeScene::populateScene()
     // Draw Connections
     const auto& connections = m_appContext.getActiveScene()->getConnections();
     for (const auto& connection : connections) {
-        auto fromNodeIt = nodes.find(connection.nodeSource);
-        auto toNodeIt = nodes.find(connection.nodeTarget);
+        const auto* fromNode = nodes.find(connection.nodeSource);
+        const auto* toNode = nodes.find(connection.nodeTarget);
 
-        if (fromNodeIt == nodes.end() || toNodeIt == nodes.end()) {
+        if (!fromNode || !toNode) {
             spdlog::error("NodeScene::populateScene - Connection references invalid node handle");
             continue;
         }
@@ -142,10 +142,10 @@ void NodeScene::populateScene()
 
         for (auto item : items()) {
             if (auto nodeItem = dynamic_cast<NodeItem*>(item)) {
-                if (nodeItem->getNode() == fromNodeIt->second) {
+                if (nodeItem->getNode() == *fromNode) {
                     fromNodeItem = nodeItem;
                 }
-                if (nodeItem->getNode() == toNodeIt->second) {
+                if (nodeItem->getNode() == *toNode) {
                     toNodeItem = nodeItem;
                 }
             }
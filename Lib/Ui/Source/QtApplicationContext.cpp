@@ -9,4 +9,20 @@ void QtApplicationContext::setupEventSubscriptions()
     }));
 }
 
+void QtApplicationContext::enableAsyncEvaluation()
+{
+    m_asyncEvaluator.reset();
+    m_evaluatedScene = getActiveScene();
+    m_evaluationSnapshot.reset();
+
+    m_asyncEvaluator = std::make_unique<core::AsyncEvaluator>(*m_evaluatedScene);
+    m_asyncEvaluator->setCompletionCallback([this](std::shared_ptr<const core::EvaluationSnapshot> snapshot) {
+        QMetaObject::invokeMethod(this, [this, snapshot]() {
+            // Completions are queued in order, so a late one never replaces a newer snapshot
+            m_evaluationSnapshot = snapshot;
+            emit evaluationCompleted(snapshot);
+        }, Qt::QueuedConnection);
+    });
+}
+
 } // namespace cf::ui
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "Core/ArrayKernels.hpp"
+#include "Core/DataTypes.hpp"
+#include "Core/InputAttribute.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "gtest/gtest.h"
+
+#include <limits>
+
+namespace cf::core::test {
+
+class ArrayKernelsTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<FloatArray>();
+        TypeRegistry::registerType<Int32Array>();
+    }
+
+    template <typename ArrayType>
+    InputAttribute<ArrayType> makeInput(const ArrayType& value)
+    {
+        AttributeDescriptor desc;
+        desc.name = "Array Attribute";
+        desc.typeHandle = TypeRegistry::getTypeHandle<ArrayType>();
+        TypeRegistry::registerAttributeDescriptor(desc);
+
+        auto attribute = std::make_shared<Attribute>(desc, ++m_nextHandle);
+        attribute->setValue(value);
+        return InputAttribute<ArrayType>(attribute);
+    }
+
+    // Sizes around every register width, so both the vector loops and their
+    // tails run, with the kernels of every level this CPU supports
+    template <typename ArrayType, typename Reference>
+    void expectMatchesReference(ArrayOp op, Reference reference)
+    {
+        for (SimdLevel level : { SimdLevel::eScalar, SimdLevel::eSSE2, SimdLevel::eAVX2 }) {
+            if (level <= getSimdLevel()) {
+                expectMatchesReference<ArrayType>(level, op, reference);
+            }
+        }
+    }
+
+    template <typename ArrayType, typename Reference>
+    void expectMatchesReference(SimdLevel level, ArrayOp op, Reference reference)
+    {
+        using Value = typename ArrayType::value_type;
+        for (size_t size = 0; size <= 37; ++size) {
+            ArrayType lhs(size);
+            ArrayType rhs(size);
+            for (size_t i = 0; i < size; ++i) {
+                lhs[i] = static_cast<Value>(i) * 3 - 20;
+                rhs[i] = static_cast<Value>(i % 7) + 1;
+            }
+
+            ArrayType result(size);
+            computeArray(level, op, std::span<const Value>(lhs), std::span<const Value>(rhs), std::span(result));
+            for (size_t i = 0; i < size; ++i) {
+                EXPECT_EQ(result[i], reference(lhs[i], rhs[i]))
+                    << "level " << static_cast<int>(level) << ", size " << size << ", index " << i;
+            }
+        }
+    }
+
+    AttributeHandle m_nextHandle { 0 };
+};
+
+TEST_F(ArrayKernelsTest, KernelsMatchScalarArithmetic)
+{
+    expectMatchesReference<FloatArray>(ArrayOp::eAdd, [](float a, float b) { return a + b; });
+    expectMatchesReference<FloatArray>(ArrayOp::eSubtract, [](float a, float b) { return a - b; });
+    expectMatchesReference<FloatArray>(ArrayOp::eMultiply, [](float a, float b) { return a * b; });
+    expectMatchesReference<FloatArray>(ArrayOp::eDivide, [](float a, float b) { return a / b; });
+
+    expectMatchesReference<DoubleArray>(ArrayOp::eAdd, [](double a, double b) { return a + b; });
+    expectMatchesReference<DoubleArray>(ArrayOp::eDivide, [](double a, double b) { return a / b; });
+
+    expectMatchesReference<Int32Array>(ArrayOp::eAdd, [](Int32 a, Int32 b) { return a + b; });
+    expectMatchesReference<Int32Array>(ArrayOp::eSubtract, [](Int32 a, Int32 b) { return a - b; });
+    expectMatchesReference<Int32Array>(ArrayOp::eMultiply, [](Int32 a, Int32 b) { return a * b; });
+    expectMatchesReference<Int32Array>(ArrayOp::eDivide, [](Int32 a, Int32 b) { return a / b; });
+}
+
+TEST_F(ArrayKernelsTest, IntegerArithmeticWraps)
+{
+    const Int32Array lhs(9, std::numeric_limits<Int32>::max());
+    const Int32Array rhs(9, 1);
+
+    for (Int32 value : computeArray(ArrayOp::eAdd, lhs, rhs)) {
+        EXPECT_EQ(value, std::numeric_limits<Int32>::min());
+    }
+}
+
+TEST_F(ArrayKernelsTest, MismatchedSizesThrow)
+{
+    const FloatArray lhs(8);
+    const FloatArray rhs(9);
+
+    EXPECT_THROW(computeArray(ArrayOp::eAdd, lhs, rhs), std::runtime_error);
+}
+
+TEST_F(ArrayKernelsTest, DefaultKernelsMatchTheWidestLevel)
+{
+    const FloatArray lhs { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f };
+    const FloatArray rhs(9, 3.0f);
+
+    FloatArray result(lhs.size());
+    computeArray(getSimdLevel(), ArrayOp::eDivide, std::span(lhs), std::span(rhs), std::span(result));
+    EXPECT_EQ(computeArray(ArrayOp::eDivide, lhs, rhs), result);
+
+    if (getSimdLevel() != SimdLevel::eAVX2) {
+        EXPECT_THROW(computeArray(SimdLevel::eAVX2, ArrayOp::eAdd, std::span(lhs), std::span(rhs), std::span(result)), std::runtime_error);
+    }
+}
+
+TEST_F(ArrayKernelsTest, InputAttributeArithmeticIsElementWise)
+{
+    auto lhs = makeInput(FloatArray { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f });
+    auto rhs = makeInput(FloatArray { 2.0f, 2.0f, 2.0f, 2.0f, 2.0f });
+
+    EXPECT_EQ(lhs + rhs, (FloatArray { 3.0f, 4.0f, 5.0f, 6.0f, 7.0f }));
+    EXPECT_EQ(lhs - rhs, (FloatArray { -1.0f, 0.0f, 1.0f, 2.0f, 3.0f }));
+    EXPECT_EQ(lhs * rhs, (FloatArray { 2.0f, 4.0f, 6.0f, 8.0f, 10.0f }));
+    EXPECT_EQ(lhs / rhs, (FloatArray { 0.5f, 1.0f, 1.5f, 2.0f, 2.5f }));
+
+    auto zeros = makeInput(Int32Array { 1, 0, 1 });
+    auto ones = makeInput(Int32Array { 1, 1, 1 });
+    EXPECT_THROW(ones / zeros, std::runtime_error);
+}
+
+} // namespace cf::core::test
@@ -0,0 +1,224 @@
+#include "Core/AsyncEvaluator.hpp"
+#include "Core/DataTypes.hpp"
+#include "Core/Nodes/AddNode.hpp"
+#include "Core/Scene.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+namespace cf::core::test {
+
+// AddNode that can be held inside compute, to edit the scene while the
+// worker is busy
+struct GatedAddNode : public NodeBase<GatedAddNode> {
+    struct Inputs {
+        InputAttribute<float> input1;
+        InputAttribute<float> input2;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<float> result;
+    } outputs;
+
+    Status compute() override
+    {
+        isComputing = true;
+        while (isClosed) {
+            std::this_thread::yield();
+        }
+        isComputing = false;
+
+        outputs.result = inputs.input1 + inputs.input2;
+        return Status::eOK;
+    }
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "cf::core::test::GatedAddNode";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(&Inputs::input1, "Input 1"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(&Inputs::input2, "Input 2"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(&Outputs::result, "Result"));
+
+        return descriptor;
+    }
+
+    static inline std::atomic<bool> isClosed { false };
+    static inline std::atomic<bool> isComputing { false };
+};
+
+class AsyncEvaluatorTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<Float>();
+        TypeRegistry::registerNodeType<AddNode>();
+        TypeRegistry::registerNodeType<GatedAddNode>();
+        GatedAddNode::isClosed = false;
+    }
+
+    Scene scene;
+};
+
+TEST_F(AsyncEvaluatorTest, PublishesInitialSnapshot)
+{
+    auto node = scene.addNode(std::make_unique<AddNode>());
+    scene.getAttribute(node->inputs.input1.getHandle())->setValue(2.0f);
+    scene.getAttribute(node->inputs.input2.getHandle())->setValue(3.0f);
+
+    AsyncEvaluator evaluator(scene);
+    evaluator.waitUntilIdle();
+
+    auto snapshot = evaluator.getSnapshot();
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(snapshot->getGeneration(), 1u);
+    EXPECT_FLOAT_EQ(snapshot->getValue<float>(node->outputs.result.getHandle()), 5.0f);
+}
+
+TEST_F(AsyncEvaluatorTest, EditsAreEvaluatedOffTheSceneThread)
+{
+    auto nodeA = scene.addNode(std::make_unique<AddNode>());
+    auto nodeB = scene.addNode(std::make_unique<AddNode>());
+    scene.addConnection(nodeA->outputs.result.getHandle(), nodeB->inputs.input1.getHandle());
+    scene.evaluate();
+
+    AsyncEvaluator evaluator(scene);
+    evaluator.waitUntilIdle();
+    auto first = evaluator.getSnapshot();
+
+    std::atomic<int> completions { 0 };
+    std::atomic<std::thread::id> callbackThread;
+    evaluator.setCompletionCallback([&](std::shared_ptr<const EvaluationSnapshot>) {
+        callbackThread = std::this_thread::get_id();
+        ++completions;
+    });
+
+    auto result = scene.getAttribute(nodeB->outputs.result.getHandle());
+    scene.getAttribute(nodeA->inputs.input1.getHandle())->setValue(4.0f);
+    evaluator.waitUntilIdle();
+
+    auto second = evaluator.getSnapshot();
+    EXPECT_EQ(completions, 1);
+    EXPECT_NE(callbackThread.load(), std::this_thread::get_id());
+    EXPECT_EQ(second->getGeneration(), first->getGeneration() + 1);
+    EXPECT_FLOAT_EQ(second->getValue<float>(nodeB->outputs.result.getHandle()), 4.0f);
+
+    // The scene is left to the evaluator, and older snapshots do not change
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 0.0f);
+    EXPECT_FLOAT_EQ(first->getValue<float>(nodeB->outputs.result.getHandle()), 0.0f);
+
+    const auto& changed = second->getChangedAttributes();
+    EXPECT_NE(std::ranges::find(changed, nodeA->inputs.input1.getHandle()), changed.end());
+    EXPECT_NE(std::ranges::find(changed, nodeB->outputs.result.getHandle()), changed.end());
+    EXPECT_EQ(std::ranges::find(changed, nodeA->inputs.input2.getHandle()), changed.end());
+}
+
+TEST_F(AsyncEvaluatorTest, EditsDuringEvaluationAreCoalesced)
+{
+    auto node = scene.addNode(std::make_unique<GatedAddNode>());
+    auto input = scene.getAttribute(node->inputs.input1.getHandle());
+
+    AsyncEvaluator evaluator(scene);
+    evaluator.waitUntilIdle();
+
+    std::atomic<int> completions { 0 };
+    evaluator.setCompletionCallback([&](std::shared_ptr<const EvaluationSnapshot>) { ++completions; });
+
+    GatedAddNode::isClosed = true;
+    input->setValue(1.0f);
+    while (!GatedAddNode::isComputing) {
+        std::this_thread::yield();
+    }
+
+    for (int i = 2; i <= 10; ++i) {
+        input->setValue(static_cast<float>(i));
+    }
+    GatedAddNode::isClosed = false;
+    evaluator.waitUntilIdle();
+
+    EXPECT_EQ(completions, 2);
+    EXPECT_FLOAT_EQ(evaluator.getSnapshot()->getValue<float>(node->outputs.result.getHandle()), 10.0f);
+}
+
+TEST_F(AsyncEvaluatorTest, EditsCancelTheEvaluationInFlight)
+{
+    auto gated = scene.addNode(std::make_unique<GatedAddNode>());
+    auto downstream = scene.addNode(std::make_unique<AddNode>());
+    scene.addConnection(gated->outputs.result.getHandle(), downstream->inputs.input1.getHandle());
+    auto input = scene.getAttribute(gated->inputs.input1.getHandle());
+
+    AsyncEvaluator evaluator(scene);
+    evaluator.waitUntilIdle();
+
+    std::atomic<int> completions { 0 };
+    evaluator.setCompletionCallback([&](std::shared_ptr<const EvaluationSnapshot>) { ++completions; });
+
+    GatedAddNode::isClosed = true;
+    input->setValue(1.0f);
+    while (!GatedAddNode::isComputing) {
+        std::this_thread::yield();
+    }
+
+    // Stops the first evaluation before the downstream node
+    input->setValue(2.0f);
+    GatedAddNode::isClosed = false;
+    evaluator.waitUntilIdle();
+
+    EXPECT_EQ(completions, 1);
+    auto snapshot = evaluator.getSnapshot();
+    EXPECT_FLOAT_EQ(snapshot->getValue<float>(downstream->outputs.result.getHandle()), 2.0f);
+
+    const auto& changed = snapshot->getChangedAttributes();
+    EXPECT_TRUE(std::ranges::binary_search(changed, gated->outputs.result.getHandle()));
+    EXPECT_TRUE(std::ranges::binary_search(changed, downstream->outputs.result.getHandle()));
+}
+
+TEST_F(AsyncEvaluatorTest, PicksUpTopologyChanges)
+{
+    auto nodeA = scene.addNode(std::make_unique<AddNode>());
+    auto nodeB = scene.addNode(std::make_unique<AddNode>());
+    scene.getAttribute(nodeA->inputs.input1.getHandle())->setValue(6.0f);
+
+    AsyncEvaluator evaluator(scene);
+    evaluator.waitUntilIdle();
+    EXPECT_FLOAT_EQ(evaluator.getSnapshot()->getValue<float>(nodeB->outputs.result.getHandle()), 0.0f);
+
+    scene.addConnection(nodeA->outputs.result.getHandle(), nodeB->inputs.input1.getHandle());
+    evaluator.requestEvaluation();
+    evaluator.waitUntilIdle();
+
+    EXPECT_FLOAT_EQ(evaluator.getSnapshot()->getValue<float>(nodeB->outputs.result.getHandle()), 6.0f);
+}
+
+TEST_F(AsyncEvaluatorTest, NodesRemovedMidEvaluationStayAliveUntilItEnds)
+{
+    auto add = scene.addNode(std::make_unique<AddNode>());
+    auto gated = scene.addNode(std::make_unique<GatedAddNode>());
+    scene.getAttribute(add->inputs.input1.getHandle())->setValue(1.0f);
+    const AttributeHandle gatedOutput = gated->outputs.result.getHandle();
+
+    AsyncEvaluator evaluator(scene);
+    evaluator.waitUntilIdle();
+
+    GatedAddNode::isClosed = true;
+    scene.getAttribute(gated->inputs.input1.getHandle())->setValue(2.0f);
+    while (!GatedAddNode::isComputing) {
+        std::this_thread::yield();
+    }
+
+    // Neither the scene nor the test holds the node any more, only the plan
+    // the worker is evaluating
+    scene.removeNode(gated->getHandle());
+    gated.reset();
+    GatedAddNode::isClosed = false;
+    evaluator.waitUntilIdle();
+
+    auto snapshot = evaluator.getSnapshot();
+    ASSERT_TRUE(snapshot);
+    EXPECT_FALSE(snapshot->contains(gatedOutput));
+    EXPECT_FLOAT_EQ(snapshot->getValue<float>(add->outputs.result.getHandle()), 1.0f);
+}
+
+} // namespace cf::core::test
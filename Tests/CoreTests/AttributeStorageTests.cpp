@@ -0,0 +1,76 @@
+#include "Core/AttributeStorage.hpp"
+#include "Core/DataTypes.hpp"
+#include "Core/Nodes/AddNode.hpp"
+#include "Core/Scene.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "gtest/gtest.h"
+
+namespace cf::core::test {
+
+class AttributeStorageTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<Float>();
+        TypeRegistry::registerType<String>();
+        TypeRegistry::registerNodeType<AddNode>();
+    }
+};
+
+TEST_F(AttributeStorageTest, ValuesOfATypeAreContiguous)
+{
+    AttributeStorage storage;
+    const TypeHandle floatHandle = TypeRegistry::getTypeHandle<Float>();
+
+    auto* first = static_cast<Float*>(storage.allocate(floatHandle));
+    auto* second = static_cast<Float*>(storage.allocate(floatHandle));
+    storage.allocate(TypeRegistry::getTypeHandle<String>());
+    auto* third = static_cast<Float*>(storage.allocate(floatHandle));
+
+    EXPECT_EQ(second, first + 1);
+    EXPECT_EQ(third, first + 2);
+    EXPECT_FLOAT_EQ(*first, 0.0f);
+    EXPECT_EQ(storage.getValueCount(floatHandle), 3u);
+}
+
+TEST_F(AttributeStorageTest, ReleasedSlotsAreReused)
+{
+    AttributeStorage storage;
+    const TypeHandle stringHandle = TypeRegistry::getTypeHandle<String>();
+
+    std::vector<void*> values;
+    for (uint32_t i = 0; i < AttributeStorage::kChunkCapacity + 1; ++i) {
+        values.push_back(storage.allocate(stringHandle));
+        *static_cast<String*>(values.back()) = "a value long enough to allocate its own buffer";
+    }
+
+    // The last value starts a second chunk; the first one is reused once released
+    storage.release(stringHandle, values.front());
+    EXPECT_EQ(storage.getValueCount(stringHandle), AttributeStorage::kChunkCapacity);
+    EXPECT_EQ(storage.allocate(stringHandle), values.front());
+    EXPECT_TRUE(static_cast<String*>(values.front())->empty());
+
+    storage.release(stringHandle, values.back());
+    EXPECT_THROW(storage.release(stringHandle, values.back()), std::runtime_error);
+}
+
+TEST_F(AttributeStorageTest, SceneAttributesShareTypedColumns)
+{
+    Scene scene;
+    auto first = scene.addNode(std::make_unique<AddNode>());
+    auto second = scene.addNode(std::make_unique<AddNode>());
+
+    auto firstInput = scene.getAttribute(first->inputs.input1.getHandle());
+    auto firstOutput = scene.getAttribute(first->outputs.result.getHandle());
+    auto secondInput = scene.getAttribute(second->inputs.input1.getHandle());
+
+    // Three float attributes per node, laid out in creation order
+    EXPECT_FALSE(firstInput->isValueInline());
+    EXPECT_EQ(static_cast<const Float*>(firstOutput->getData()), static_cast<const Float*>(firstInput->getData()) + 2);
+    EXPECT_EQ(static_cast<const Float*>(secondInput->getData()), static_cast<const Float*>(firstInput->getData()) + 3);
+
+    scene.getAttribute(first->inputs.input2.getHandle())->setValue(2.0f);
+    EXPECT_FLOAT_EQ(firstOutput->getValue<Float>(), 2.0f);
+}
+
+} // namespace cf::core::test
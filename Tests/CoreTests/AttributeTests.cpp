@@ -1,5 +1,6 @@
 #include "Core/Attribute.hpp"
 #include "Core/DataTypes.hpp"
+#include "Core/SharedValue.hpp"
 #include "Core/TypeRegistry.hpp"
 #include "gtest/gtest.h"
 
@@ -96,6 +97,20 @@ TEST_F(AttributeTest, TypeMismatch)
     EXPECT_THROW(attr.setValue(3.14f), std::runtime_error);
 }
 
+TEST_F(AttributeTest, SourceOfAnotherTypeIsRejected)
+{
+    Attribute target(intDescriptor, kTestableHandle);
+    Attribute source(stringDescriptor, kTestableHandle + 1);
+
+    EXPECT_THROW(target.setSource(&source), std::runtime_error);
+    EXPECT_EQ(target.getSource(), nullptr);
+
+    Attribute intSource(intDescriptor, kTestableHandle + 2);
+    intSource.setValue(5);
+    target.setSource(&intSource);
+    EXPECT_EQ(target.getValue<Int32>(), 5);
+}
+
 /*--------------------------------------------------------------*/
 /*---------------------Assignment-to-Attribute------------------*/
 /*--------------------------------------------------------------*/
@@ -169,3 +184,98 @@ TEST_F(AttributeTest, AttributeConstReference)
 /*--------------------------------------------------------------*/
 /*---------------------End Assignment-to-Attribute--------------*/
 /*--------------------------------------------------------------*/
+
+TEST_F(AttributeTest, SharedValueCopiesShareTheBlock)
+{
+    using Samples = SharedFloatArray;
+
+    Samples original(std::vector<float>(1024, 1.0f));
+    Samples copy = original;
+    EXPECT_TRUE(copy.isSharedWith(original));
+    EXPECT_EQ(original.getUseCount(), 2);
+
+    // Editing a shared value clones it and leaves the other copy untouched
+    copy.edit()[0] = 2.0f;
+    EXPECT_FALSE(copy.isSharedWith(original));
+    EXPECT_FLOAT_EQ(original.get()[0], 1.0f);
+    EXPECT_FLOAT_EQ(copy.get()[0], 2.0f);
+
+    // Once unique, edits happen in place
+    const float* block = copy->data();
+    copy.edit()[1] = 3.0f;
+    EXPECT_EQ(copy->data(), block);
+
+    Samples empty;
+    EXPECT_TRUE(empty->empty());
+    empty.edit().push_back(4.0f);
+    EXPECT_EQ(empty->size(), 1);
+}
+
+TEST_F(AttributeTest, SharedValueAttributesCopyWithoutDuplicating)
+{
+    using Samples = SharedFloatArray;
+    TypeRegistry::registerType<Samples>();
+
+    AttributeDescriptor desc;
+    desc.name = "Samples Attribute";
+    desc.typeHandle = TypeRegistry::getTypeHandle<Samples>();
+    TypeRegistry::registerAttributeDescriptor(desc);
+
+    Attribute attr(desc, kTestableHandle);
+    Samples value(std::vector<float>(1024, 1.0f));
+    attr.setValue(value);
+    EXPECT_TRUE(attr.getValue<Samples>().isSharedWith(value));
+
+    // Undo snapshots copy through the type descriptor, which shares the block
+    AttributeEditRecorder recorder;
+    attr.setValue(Samples(std::vector<float>(16, 2.0f)));
+    ASSERT_EQ(recorder.getEdits().size(), 1);
+    EXPECT_TRUE(static_cast<const Samples*>(recorder.getEdits()[0].previousValue.get())->isSharedWith(value));
+}
+
+TEST_F(AttributeTest, SharedValueIsOnlyComparableWhenItsTypeIs)
+{
+    struct Opaque {
+        int value { 0 };
+    };
+    TypeRegistry::registerType<SharedFloatArray>();
+    TypeRegistry::registerType<SharedValue<Opaque>>();
+
+    static_assert(std::equality_comparable<SharedFloatArray>);
+    static_assert(!std::equality_comparable<SharedValue<Opaque>>);
+    EXPECT_EQ(getTypeName<SharedFloatArray>(), "cf::core::SharedFloatArray");
+    EXPECT_NE(TypeRegistry::getTypeDescriptor<SharedFloatArray>().equal, nullptr);
+    EXPECT_EQ(TypeRegistry::getTypeDescriptor<SharedValue<Opaque>>().equal, nullptr);
+}
+
+TEST_F(AttributeTest, SmallValuesAreStoredInline)
+{
+    struct LargeValue {
+        double values[8] {};
+    };
+    TypeRegistry::registerType<LargeValue>();
+
+    AttributeDescriptor largeDescriptor;
+    largeDescriptor.name = "Large Attribute";
+    largeDescriptor.typeHandle = TypeRegistry::getTypeHandle<LargeValue>();
+    TypeRegistry::registerAttributeDescriptor(largeDescriptor);
+
+    Attribute intAttr(intDescriptor, kTestableHandle);
+    Attribute stringAttr(stringDescriptor, kTestableHandle);
+    Attribute largeAttr(largeDescriptor, kTestableHandle);
+
+    EXPECT_TRUE(intAttr.isValueInline());
+    EXPECT_EQ(intAttr.getValue<Int32>(), 0);
+    intAttr.setValue(7);
+    EXPECT_EQ(intAttr.getValue<Int32>(), 7);
+
+    EXPECT_EQ(stringAttr.isValueInline(), sizeof(String) <= Attribute::kInlineStorageSize);
+    stringAttr.setValue(String("a string long enough to live on the heap itself"));
+    EXPECT_EQ(stringAttr.getValue<String>(), "a string long enough to live on the heap itself");
+
+    EXPECT_FALSE(largeAttr.isValueInline());
+    LargeValue large;
+    large.values[7] = 3.0;
+    largeAttr.setValue(large);
+    EXPECT_DOUBLE_EQ(largeAttr.getValue<LargeValue>().values[7], 3.0);
+}
@@ -0,0 +1,117 @@
+#include "Core/DataTypes.hpp"
+#include "Core/EvaluationContext.hpp"
+#include "Core/Nodes/AddNode.hpp"
+#include "Core/Scene.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "gtest/gtest.h"
+
+#include <thread>
+
+namespace cf::core::test {
+
+class EvaluationContextTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<Float>();
+        TypeRegistry::registerNodeType<AddNode>();
+    }
+
+    // Chain of AddNodes where each node adds its second input to the previous result
+    std::vector<std::shared_ptr<AddNode>> buildChain(size_t length)
+    {
+        std::vector<std::shared_ptr<AddNode>> nodes;
+        for (size_t i = 0; i < length; ++i) {
+            nodes.push_back(scene.addNode(std::make_unique<AddNode>()));
+            scene.getAttribute(nodes.back()->inputs.input2.getHandle())->setValue(1.0f);
+            if (i > 0) {
+                scene.addConnection(nodes[i - 1]->outputs.result.getHandle(), nodes[i]->inputs.input1.getHandle());
+            }
+        }
+
+        // Connecting only marks the scene dirty
+        scene.evaluate();
+        return nodes;
+    }
+
+    float sceneValue(AttributeHandle handle) const { return scene.getAttribute(handle)->getValue<float>(); }
+
+    Scene scene;
+};
+
+TEST_F(EvaluationContextTest, StartsFromSceneValues)
+{
+    auto nodes = buildChain(3);
+    EvaluationContext context(scene);
+
+    EXPECT_EQ(context.getDirtyNodeCount(), 0u);
+    EXPECT_FLOAT_EQ(context.getValue<float>(nodes.back()->outputs.result.getHandle()), 3.0f);
+}
+
+TEST_F(EvaluationContextTest, EditsStayInTheContext)
+{
+    auto nodes = buildChain(3);
+    EvaluationContext context(scene);
+
+    context.setValue(nodes.front()->inputs.input1.getHandle(), 10.0f);
+    EXPECT_EQ(context.getDirtyNodeCount(), 3u);
+
+    context.evaluate();
+    EXPECT_FLOAT_EQ(context.getValue<float>(nodes.back()->outputs.result.getHandle()), 13.0f);
+
+    EXPECT_FLOAT_EQ(sceneValue(nodes.front()->inputs.input1.getHandle()), 0.0f);
+    EXPECT_FLOAT_EQ(sceneValue(nodes.back()->outputs.result.getHandle()), 3.0f);
+    EXPECT_EQ(scene.getDirtyNodeCount(), 0u);
+}
+
+TEST_F(EvaluationContextTest, EditRecomputesOnlyDownstreamNodes)
+{
+    auto nodes = buildChain(3);
+    EvaluationContext context(scene);
+
+    context.setValue(nodes[1]->inputs.input2.getHandle(), 5.0f);
+    EXPECT_FALSE(context.isDirty(scene.getNodeHandle(nodes[0])));
+    EXPECT_TRUE(context.isDirty(scene.getNodeHandle(nodes[1])));
+    EXPECT_TRUE(context.isDirty(scene.getNodeHandle(nodes[2])));
+
+    context.evaluate();
+    EXPECT_FLOAT_EQ(context.getValue<float>(nodes.back()->outputs.result.getHandle()), 7.0f);
+}
+
+TEST_F(EvaluationContextTest, ContextsEvaluateConcurrently)
+{
+    constexpr size_t kChainLength = 64;
+    constexpr size_t kContextCount = 8;
+    auto nodes = buildChain(kChainLength);
+
+    std::vector<std::unique_ptr<EvaluationContext>> contexts;
+    for (size_t i = 0; i < kContextCount; ++i) {
+        contexts.push_back(std::make_unique<EvaluationContext>(scene));
+        contexts.back()->setValue(nodes.front()->inputs.input1.getHandle(), static_cast<float>(i * 100));
+    }
+
+    std::vector<std::thread> threads;
+    for (auto& context : contexts) {
+        threads.emplace_back([&context] { context->evaluate(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const AttributeHandle result = nodes.back()->outputs.result.getHandle();
+    for (size_t i = 0; i < kContextCount; ++i) {
+        EXPECT_FLOAT_EQ(contexts[i]->getValue<float>(result), static_cast<float>(i * 100 + kChainLength)) << "context " << i;
+    }
+    EXPECT_FLOAT_EQ(sceneValue(result), static_cast<float>(kChainLength));
+}
+
+TEST_F(EvaluationContextTest, ValueAccessChecksTypeAndOwnership)
+{
+    auto nodes = buildChain(1);
+    EvaluationContext context(scene);
+
+    EXPECT_THROW(context.getValue<double>(nodes.front()->outputs.result.getHandle()), std::runtime_error);
+    EXPECT_THROW(context.getValue<float>(kInvalidAttributeHandle), std::runtime_error);
+}
+
+} // namespace cf::core::test
@@ -0,0 +1,200 @@
+#include "Core/DataTypes.hpp"
+#include "Core/Nodes/AddNode.hpp"
+#include "Core/SampleBatch.hpp"
+#include "Core/Scene.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "gtest/gtest.h"
+
+namespace cf::core::test {
+
+// Same computation as AddNode, without a batch compute
+struct ScalarMultiplyNode : public NodeBase<ScalarMultiplyNode> {
+    struct Inputs {
+        InputAttribute<float> input1;
+        InputAttribute<float> input2;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<float> result;
+    } outputs;
+
+    Status compute() override
+    {
+        ++computeCount;
+        outputs.result = inputs.input1 * inputs.input2;
+        return Status::eOK;
+    }
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "cf::core::test::ScalarMultiplyNode";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(&Inputs::input1, "Input 1"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(&Inputs::input2, "Input 2"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(&Outputs::result, "Result"));
+
+        return descriptor;
+    }
+
+    static inline int computeCount { 0 };
+};
+
+class SampleBatchTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<Float>();
+        TypeRegistry::registerNodeType<AddNode>();
+        TypeRegistry::registerNodeType<ScalarMultiplyNode>();
+        ScalarMultiplyNode::computeCount = 0;
+    }
+
+    Scene scene;
+};
+
+TEST_F(SampleBatchTest, LanesStartFromSceneValues)
+{
+    auto node = scene.addNode(std::make_unique<AddNode>());
+    scene.getAttribute(node->inputs.input1.getHandle())->setValue(2.0f);
+    scene.getAttribute(node->inputs.input2.getHandle())->setValue(3.0f);
+
+    SampleBatch batch(scene, 4);
+    for (float value : batch.getInput(node->inputs.input1)) {
+        EXPECT_FLOAT_EQ(value, 2.0f);
+    }
+
+    batch.evaluate();
+    for (float value : batch.getOutput(node->outputs.result)) {
+        EXPECT_FLOAT_EQ(value, 5.0f);
+    }
+}
+
+TEST_F(SampleBatchTest, BatchMatchesScalarEvaluationPerSample)
+{
+    // add -> multiply -> add, mixing batch and per-sample nodes
+    auto first = scene.addNode(std::make_unique<AddNode>());
+    auto scale = scene.addNode(std::make_unique<ScalarMultiplyNode>());
+    auto last = scene.addNode(std::make_unique<AddNode>());
+
+    scene.addConnection(first->outputs.result.getHandle(), scale->inputs.input1.getHandle());
+    scene.addConnection(scale->outputs.result.getHandle(), last->inputs.input1.getHandle());
+    scene.getAttribute(scale->inputs.input2.getHandle())->setValue(2.0f);
+    scene.getAttribute(last->inputs.input2.getHandle())->setValue(0.5f);
+
+    constexpr size_t kSampleCount = 64;
+    SampleBatch batch(scene, kSampleCount);
+
+    auto input1 = batch.getLanes<float>(first->inputs.input1.getHandle());
+    auto input2 = batch.getLanes<float>(first->inputs.input2.getHandle());
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        input1[i] = static_cast<float>(i);
+        input2[i] = static_cast<float>(i) * 0.25f;
+    }
+
+    batch.evaluate();
+    auto results = batch.getOutput(last->outputs.result);
+
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        scene.getAttribute(first->inputs.input1.getHandle())->setValue(input1[i]);
+        scene.getAttribute(first->inputs.input2.getHandle())->setValue(input2[i]);
+
+        EXPECT_FLOAT_EQ(results[i], scene.getAttribute(last->outputs.result.getHandle())->getValue<float>()) << "sample " << i;
+    }
+}
+
+TEST_F(SampleBatchTest, EvaluationLeavesSceneUntouched)
+{
+    auto source = scene.addNode(std::make_unique<AddNode>());
+    auto scale = scene.addNode(std::make_unique<ScalarMultiplyNode>());
+    scene.addConnection(source->outputs.result.getHandle(), scale->inputs.input1.getHandle());
+
+    scene.getAttribute(source->inputs.input1.getHandle())->setValue(1.0f);
+    scene.getAttribute(scale->inputs.input2.getHandle())->setValue(3.0f);
+    ASSERT_FLOAT_EQ(scene.getAttribute(scale->outputs.result.getHandle())->getValue<float>(), 3.0f);
+
+    SampleBatch batch(scene, 8);
+    std::ranges::fill(batch.getLanes<float>(source->inputs.input1.getHandle()), 10.0f);
+    batch.evaluate();
+
+    EXPECT_FLOAT_EQ(batch.getOutput(scale->outputs.result)[7], 30.0f);
+    EXPECT_FLOAT_EQ(scene.getAttribute(scale->outputs.result.getHandle())->getValue<float>(), 3.0f);
+    EXPECT_FLOAT_EQ(scene.getAttribute(scale->inputs.input1.getHandle())->getValue<float>(), 1.0f);
+    EXPECT_EQ(scene.getDirtyNodeCount(), 0u);
+}
+
+TEST_F(SampleBatchTest, ConstantNodesAreComputedOnce)
+{
+    // constant multiply -> add with a varying second input
+    auto constant = scene.addNode(std::make_unique<ScalarMultiplyNode>());
+    auto varying = scene.addNode(std::make_unique<AddNode>());
+    scene.addConnection(constant->outputs.result.getHandle(), varying->inputs.input1.getHandle());
+    scene.getAttribute(constant->inputs.input1.getHandle())->setValue(2.0f);
+    scene.getAttribute(constant->inputs.input2.getHandle())->setValue(3.0f);
+    ScalarMultiplyNode::computeCount = 0;
+
+    constexpr size_t kSampleCount = 16;
+    SampleBatch batch(scene, kSampleCount);
+    auto offsets = batch.getLanes<float>(varying->inputs.input2.getHandle());
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        offsets[i] = static_cast<float>(i);
+    }
+    EXPECT_EQ(batch.getConstantNodeCount(), 1u);
+
+    batch.evaluate();
+    batch.evaluate();
+
+    EXPECT_EQ(ScalarMultiplyNode::computeCount, 1);
+    auto results = batch.getOutput(varying->outputs.result);
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        EXPECT_FLOAT_EQ(results[i], 6.0f + static_cast<float>(i));
+    }
+}
+
+TEST_F(SampleBatchTest, SettingAnInputRecomputesConstantNodes)
+{
+    auto node = scene.addNode(std::make_unique<ScalarMultiplyNode>());
+    ScalarMultiplyNode::computeCount = 0;
+
+    constexpr size_t kSampleCount = 8;
+    SampleBatch batch(scene, kSampleCount);
+    batch.setInput(node->inputs.input1.getHandle(), 4.0f);
+    batch.setInput(node->inputs.input2.getHandle(), 0.5f);
+    batch.evaluate();
+    EXPECT_EQ(ScalarMultiplyNode::computeCount, 1);
+    EXPECT_FLOAT_EQ(batch.getOutput(node->outputs.result)[kSampleCount - 1], 2.0f);
+
+    batch.setInput(node->inputs.input2.getHandle(), 2.0f);
+    batch.evaluate();
+    batch.evaluate();
+    EXPECT_EQ(ScalarMultiplyNode::computeCount, 2);
+    EXPECT_FLOAT_EQ(batch.getOutput(node->outputs.result)[kSampleCount - 1], 8.0f);
+
+    // Writable lanes may differ per sample, so the node is computed per sample
+    batch.getLanes<float>(node->inputs.input1.getHandle())[0] = 1.0f;
+    EXPECT_EQ(batch.getConstantNodeCount(), 0u);
+    batch.evaluate();
+    EXPECT_EQ(ScalarMultiplyNode::computeCount, 2 + static_cast<int>(kSampleCount));
+    EXPECT_FLOAT_EQ(batch.getOutput(node->outputs.result)[0], 2.0f);
+}
+
+TEST_F(SampleBatchTest, ConnectedInputsShareSourceLanes)
+{
+    auto source = scene.addNode(std::make_unique<AddNode>());
+    auto target = scene.addNode(std::make_unique<AddNode>());
+    scene.addConnection(source->outputs.result.getHandle(), target->inputs.input2.getHandle());
+
+    SampleBatch batch(scene, 16);
+    EXPECT_EQ(batch.getInput(target->inputs.input2).data(), batch.getOutput(source->outputs.result).data());
+}
+
+TEST_F(SampleBatchTest, LaneAccessChecksTypeAndOwnership)
+{
+    auto node = scene.addNode(std::make_unique<AddNode>());
+    SampleBatch batch(scene, 2);
+
+    EXPECT_THROW(batch.getLanes<double>(node->inputs.input1.getHandle()), std::runtime_error);
+    EXPECT_THROW(batch.getLanes<float>(kInvalidAttributeHandle), std::runtime_error);
+}
+
+} // namespace cf::core::test
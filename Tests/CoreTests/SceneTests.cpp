@@ -0,0 +1,1037 @@
+#include "Core/Commands/AddConnectionCommand.hpp"
+#include "Core/Commands/RemoveNodesCommand.hpp"
+#include "Core/DataTypes.hpp"
+#include "Core/Document.hpp"
+#include "Core/Events/NodeEvent.hpp"
+#include "Core/Nodes/AddNode.hpp"
+#include "Core/Nodes/MultiplyMatrixNode.hpp"
+#include "Core/Scene.hpp"
+#include "Core/SceneTransaction.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "Core/UndoStack.hpp"
+#include "gtest/gtest.h"
+
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace cf::core::test {
+
+struct CountingAddNode : public NodeBase<CountingAddNode> {
+    struct Inputs {
+        InputAttribute<float> input1;
+        InputAttribute<float> input2;
+    } inputs;
+
+    struct Outputs {
+        OutputAttribute<float> result;
+    } outputs;
+
+    Status compute() override
+    {
+        ++computeCount;
+        if (shouldThrow) {
+            throw std::runtime_error("CountingAddNode failed");
+        }
+        outputs.result = inputs.input1 + inputs.input2;
+        return Status::eOK;
+    }
+
+    static NodeDescriptor initialize()
+    {
+        NodeDescriptor descriptor;
+        descriptor.typeName = "cf::core::test::CountingAddNode";
+
+        descriptor.attributes.push_back(addInputAttributeDescriptor(&Inputs::input1, "Input 1"));
+        descriptor.attributes.push_back(addInputAttributeDescriptor(&Inputs::input2, "Input 2"));
+        descriptor.attributes.push_back(addOutputAttributeDescriptor(&Outputs::result, "Result"));
+
+        return descriptor;
+    }
+
+    int computeCount { 0 };
+    bool shouldThrow { false };
+};
+
+class SceneTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<Float>();
+        TypeRegistry::registerType<Mat4>();
+        TypeRegistry::registerNodeType<AddNode>();
+        TypeRegistry::registerNodeType<MultiplyMatrixNode>();
+        TypeRegistry::registerNodeType<CountingAddNode>();
+    }
+
+    std::shared_ptr<CountingAddNode> addCountingNode()
+    {
+        return scene.addNode(std::make_unique<CountingAddNode>());
+    }
+
+    Scene scene;
+};
+
+TEST_F(SceneTest, HandlesResolveToTheirNodeAndAttributes)
+{
+    auto node = addCountingNode();
+    const NodeHandle handle = scene.getNodeHandle(node);
+
+    EXPECT_NE(handle, kInvalidNodeHandle);
+    EXPECT_EQ(node->getHandle(), handle);
+    EXPECT_EQ(scene.getNode(handle), node);
+    EXPECT_EQ(scene.getAttributeNode(node->inputs.input1.getHandle()), handle);
+
+    // Only the generation differs, so the slot index alone does not resolve
+    const NodeHandle stale = makeSlotHandle(getSlotIndex(handle), getSlotGeneration(handle) + 1);
+    EXPECT_EQ(scene.getNode(stale), nullptr);
+    EXPECT_EQ(scene.getAttribute(makeSlotHandle(getSlotIndex(node->inputs.input1.getHandle()), 7)), nullptr);
+
+    Scene other;
+    EXPECT_EQ(other.getNodeHandle(node), kInvalidNodeHandle);
+}
+
+TEST_F(SceneTest, AttributesKeepTheirValuesAfterTheSceneIsDestroyed)
+{
+    std::shared_ptr<CountingAddNode> node;
+    std::shared_ptr<Attribute> result;
+    std::shared_ptr<Attribute> otherInput;
+    {
+        Scene local;
+        node = local.addNode(std::make_unique<CountingAddNode>());
+        local.getAttribute(node->inputs.input1.getHandle())->setValue(2.0f);
+        local.getAttribute(node->inputs.input2.getHandle())->setValue(3.0f);
+        result = local.getAttribute(node->outputs.result.getHandle());
+
+        // Held without its node
+        auto other = local.addNode(std::make_unique<CountingAddNode>());
+        otherInput = local.getAttribute(other->inputs.input1.getHandle());
+        otherInput->setValue(7.0f);
+    }
+
+    EXPECT_FLOAT_EQ(node->inputs.input1 + node->inputs.input2, 5.0f);
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 5.0f);
+    EXPECT_FLOAT_EQ(otherInput->getValue<float>(), 7.0f);
+}
+
+TEST_F(SceneTest, NodeAttributesAreListedInDescriptorOrder)
+{
+    auto first = addCountingNode();
+    auto second = addCountingNode();
+
+    auto attributes = scene.getNodeAttributes(second);
+    ASSERT_EQ(attributes.size(), 3u);
+    EXPECT_EQ(attributes[0]->getHandle(), second->inputs.input1.getHandle());
+    EXPECT_EQ(attributes[1]->getHandle(), second->inputs.input2.getHandle());
+    EXPECT_EQ(attributes[2]->getHandle(), second->outputs.result.getHandle());
+
+    EXPECT_EQ(scene.getNodeAttributes(first).size(), 3u);
+    EXPECT_TRUE(scene.getNodeAttributes(kInvalidNodeHandle).empty());
+}
+
+TEST_F(SceneTest, AddNodesBuildsConnectableNodes)
+{
+    const std::vector<NodeHandle> handles = scene.addNodes<CountingAddNode>(4);
+    ASSERT_EQ(handles.size(), 4u);
+    EXPECT_EQ(scene.getNodes().size(), 4u);
+    EXPECT_EQ(scene.getAttributes().size(), 12u);
+    EXPECT_EQ(scene.topologicalOrder(), handles);
+
+    auto first = std::static_pointer_cast<CountingAddNode>(scene.getNode(handles[0]));
+    auto second = std::static_pointer_cast<CountingAddNode>(scene.getNode(handles[1]));
+    EXPECT_EQ(first->getHandle(), handles[0]);
+    EXPECT_TRUE(scene.isDirty(handles[3]));
+
+    ASSERT_TRUE(scene.addConnection(first->outputs.result.getHandle(), second->inputs.input1.getHandle()));
+    scene.getAttribute(first->inputs.input1.getHandle())->setValue(2.0f);
+    scene.getAttribute(first->inputs.input2.getHandle())->setValue(3.0f);
+
+    EXPECT_FLOAT_EQ(scene.getAttribute(second->outputs.result.getHandle())->getValue<float>(), 5.0f);
+}
+
+TEST_F(SceneTest, NewNodesAreDirtyUntilEvaluated)
+{
+    auto node = addCountingNode();
+    NodeHandle handle = scene.getNodeHandle(node);
+
+    EXPECT_TRUE(scene.isDirty(handle));
+
+    scene.evaluate();
+    EXPECT_FALSE(scene.isDirty(handle));
+    EXPECT_EQ(node->computeCount, 1);
+
+    // Nothing changed, so nothing is recomputed
+    scene.evaluate();
+    EXPECT_EQ(node->computeCount, 1);
+}
+
+TEST_F(SceneTest, EditRecomputesOnlyDownstreamNodes)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    auto unrelated = addCountingNode();
+
+    scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+    scene.evaluate();
+
+    EXPECT_EQ(nodeA->computeCount, 1);
+    EXPECT_EQ(nodeB->computeCount, 1);
+    EXPECT_EQ(unrelated->computeCount, 1);
+
+    // Setting an attribute publishes a change and triggers an evaluation
+    scene.getAttribute(nodeA->inputs.input1.getHandle())->setValue(2.0f);
+    scene.getAttribute(nodeA->inputs.input2.getHandle())->setValue(3.0f);
+
+    EXPECT_EQ(nodeA->computeCount, 3);
+    EXPECT_EQ(nodeB->computeCount, 3);
+    EXPECT_EQ(unrelated->computeCount, 1);
+    EXPECT_EQ(scene.getDirtyNodeCount(), 0);
+
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeB->outputs.result.getHandle())->getValue<float>(), 5.0f);
+}
+
+TEST_F(SceneTest, EditOnDownstreamNodeDoesNotRecomputeUpstream)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+
+    scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+    scene.evaluate();
+
+    scene.getAttribute(nodeB->inputs.input2.getHandle())->setValue(1.0f);
+
+    EXPECT_EQ(nodeA->computeCount, 1);
+    EXPECT_EQ(nodeB->computeCount, 2);
+}
+
+TEST_F(SceneTest, MarkDirtyIgnoresForeignAttributes)
+{
+    addCountingNode();
+    scene.evaluate();
+
+    EXPECT_FALSE(scene.markDirty(kInvalidAttributeHandle));
+    EXPECT_EQ(scene.getDirtyNodeCount(), 0);
+}
+
+TEST_F(SceneTest, ConnectionChangesDirtyTheTarget)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    scene.evaluate();
+
+    AttributeHandle from = nodeA->outputs.result.getHandle();
+    AttributeHandle to = nodeB->inputs.input1.getHandle();
+
+    scene.addConnection(from, to);
+    EXPECT_FALSE(scene.isDirty(scene.getNodeHandle(nodeA)));
+    EXPECT_TRUE(scene.isDirty(scene.getNodeHandle(nodeB)));
+    scene.evaluate();
+
+    scene.removeConnection(from, to);
+    EXPECT_TRUE(scene.isDirty(scene.getNodeHandle(nodeB)));
+}
+
+TEST_F(SceneTest, AdjacencyIndexTracksConnections)
+{
+    auto source = addCountingNode();
+    auto targetA = addCountingNode();
+    auto targetB = addCountingNode();
+
+    scene.connect(source, source->outputs.result, targetA, targetA->inputs.input1);
+    scene.connect(source, source->outputs.result, targetB, targetB->inputs.input1);
+    scene.connect(targetA, targetA->outputs.result, targetB, targetB->inputs.input2);
+
+    NodeHandle sourceHandle = scene.getNodeHandle(source);
+    NodeHandle targetBHandle = scene.getNodeHandle(targetB);
+    AttributeHandle resultHandle = source->outputs.result.getHandle();
+
+    EXPECT_EQ(scene.getNodeConnections(sourceHandle).outgoing.size(), 2);
+    EXPECT_EQ(scene.getNodeConnections(sourceHandle).incoming.size(), 0);
+    EXPECT_EQ(scene.getNodeConnections(targetBHandle).incoming.size(), 2);
+    EXPECT_EQ(scene.getAttributeConnections(resultHandle).outgoing.size(), 2);
+    EXPECT_EQ(scene.getAttributeConnections(targetB->inputs.input1.getHandle()).incoming.size(), 1);
+
+    // Duplicates are rejected
+    EXPECT_FALSE(scene.addConnection(resultHandle, targetA->inputs.input1.getHandle()));
+
+    scene.removeConnection(resultHandle, targetA->inputs.input1.getHandle());
+
+    EXPECT_EQ(scene.getConnections().size(), 2);
+    EXPECT_EQ(scene.getNodeConnections(sourceHandle).outgoing.size(), 1);
+    EXPECT_EQ(scene.getNodeConnections(scene.getNodeHandle(targetA)).incoming.size(), 0);
+    EXPECT_EQ(scene.getAttributeConnections(resultHandle).outgoing.size(), 1);
+
+    // The connection moved into the freed slot can still be removed
+    scene.removeConnection(targetA->outputs.result.getHandle(), targetB->inputs.input2.getHandle());
+    scene.removeConnection(resultHandle, targetB->inputs.input1.getHandle());
+
+    EXPECT_TRUE(scene.getConnections().empty());
+    EXPECT_TRUE(scene.getNodeConnections(targetBHandle).incoming.empty());
+}
+
+TEST_F(SceneTest, ConnectionAgainstCurrentOrderReordersNodes)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    auto nodeC = addCountingNode();
+
+    // C -> B -> A is the reverse of insertion order
+    ASSERT_TRUE(scene.connect(nodeB, nodeB->outputs.result, nodeA, nodeA->inputs.input1));
+    ASSERT_TRUE(scene.connect(nodeC, nodeC->outputs.result, nodeB, nodeB->inputs.input1));
+
+    std::vector<NodeHandle> expected { scene.getNodeHandle(nodeC), scene.getNodeHandle(nodeB), scene.getNodeHandle(nodeA) };
+    EXPECT_EQ(scene.topologicalOrder(), expected);
+
+    scene.getAttribute(nodeC->inputs.input1.getHandle())->setValue(4.0f);
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeA->outputs.result.getHandle())->getValue<float>(), 4.0f);
+}
+
+TEST_F(SceneTest, ConnectionCreatingCycleIsRejected)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+
+    ASSERT_TRUE(scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1));
+
+    EXPECT_FALSE(scene.connect(nodeB, nodeB->outputs.result, nodeA, nodeA->inputs.input1));
+    EXPECT_FALSE(scene.connect(nodeA, nodeA->outputs.result, nodeA, nodeA->inputs.input2));
+    EXPECT_EQ(scene.getConnections().size(), 1);
+}
+
+TEST_F(SceneTest, ConnectionBetweenIncompatibleAttributesIsRejected)
+{
+    auto node = addCountingNode();
+    auto other = addCountingNode();
+    auto matrix = scene.addNode(std::make_unique<MultiplyMatrixNode>());
+
+    EXPECT_FALSE(scene.addConnection(node->outputs.result.getHandle(), matrix->inputs.lhs.getHandle()));
+    EXPECT_FALSE(scene.addConnection(matrix->outputs.result.getHandle(), node->inputs.input1.getHandle()));
+    EXPECT_FALSE(scene.addConnection(node->inputs.input1.getHandle(), other->inputs.input2.getHandle()));
+    EXPECT_FALSE(scene.addConnection(node->outputs.result.getHandle(), other->outputs.result.getHandle()));
+    EXPECT_TRUE(scene.getConnections().empty());
+
+    EXPECT_TRUE(scene.addConnection(node->outputs.result.getHandle(), other->inputs.input1.getHandle()));
+}
+
+TEST_F(SceneTest, RejectedConnectionCommandLeavesExistingConnection)
+{
+    auto sharedScene = std::make_shared<Scene>();
+    auto nodeA = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    auto nodeB = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    const AttributeHandle from = nodeA->outputs.result.getHandle();
+    const AttributeHandle to = nodeB->inputs.input1.getHandle();
+
+    UndoStack undoStack;
+    undoStack.push(std::make_unique<AddConnectionCommand>(sharedScene, from, to));
+    ASSERT_EQ(sharedScene->getConnections().size(), 1u);
+
+    // The duplicate is rejected, so it is not kept for undo
+    undoStack.push(std::make_unique<AddConnectionCommand>(sharedScene, from, to));
+    EXPECT_EQ(sharedScene->getConnections().size(), 1u);
+    undoStack.undo();
+    EXPECT_TRUE(sharedScene->getConnections().empty());
+    EXPECT_FALSE(undoStack.canUndo());
+
+    // Undoing a rejected command directly does not remove the real connection
+    sharedScene->addConnection(from, to);
+    AddConnectionCommand duplicate(sharedScene, from, to);
+    duplicate.execute();
+    EXPECT_FALSE(duplicate.hasEffect());
+    duplicate.undo();
+    EXPECT_EQ(sharedScene->getConnections().size(), 1u);
+}
+
+TEST_F(SceneTest, InputReadsItsMostRecentConnection)
+{
+    std::vector<std::shared_ptr<CountingAddNode>> sources;
+    for (float value : { 1.0f, 2.0f, 3.0f }) {
+        sources.push_back(addCountingNode());
+        scene.getAttribute(sources.back()->inputs.input1.getHandle())->setValue(value);
+    }
+    auto target = addCountingNode();
+    const AttributeHandle input = target->inputs.input1.getHandle();
+    for (const auto& source : sources) {
+        ASSERT_TRUE(scene.addConnection(source->outputs.result.getHandle(), input));
+    }
+    scene.evaluate();
+    EXPECT_FLOAT_EQ(scene.getAttribute(input)->getValue<float>(), 3.0f);
+
+    // Removing an older connection leaves the input on the most recent one
+    scene.removeConnection(sources[0]->outputs.result.getHandle(), input);
+    scene.evaluate();
+    EXPECT_FLOAT_EQ(scene.getAttribute(input)->getValue<float>(), 3.0f);
+
+    // Removing the most recent one falls back to the next most recent
+    scene.removeConnection(sources[2]->outputs.result.getHandle(), input);
+    scene.evaluate();
+    EXPECT_FLOAT_EQ(scene.getAttribute(input)->getValue<float>(), 2.0f);
+}
+
+TEST_F(SceneTest, ConnectionToNodeOutsideTheSceneIsRejected)
+{
+    auto node = addCountingNode();
+
+    Scene other;
+    auto foreign = other.addNode(std::make_unique<CountingAddNode>());
+    auto removed = addCountingNode();
+    RemovedNodes held = scene.removeNode(removed->getHandle());
+
+    EXPECT_FALSE(scene.connect(node, node->outputs.result, foreign, foreign->inputs.input1));
+    EXPECT_FALSE(scene.connect(foreign, foreign->outputs.result, node, node->inputs.input1));
+    EXPECT_FALSE(scene.connect(removed, removed->outputs.result, node, node->inputs.input1));
+    EXPECT_TRUE(scene.getConnections().empty());
+}
+
+TEST_F(SceneTest, IncrementalOrderStaysConsistentWithConnections)
+{
+    constexpr size_t kNodeCount = 64;
+
+    std::vector<std::shared_ptr<CountingAddNode>> nodes;
+    for (size_t i = 0; i < kNodeCount; ++i) {
+        nodes.push_back(addCountingNode());
+    }
+
+    // Connect along a random hidden order so most edges go against insertion order
+    std::vector<size_t> rank(kNodeCount);
+    std::iota(rank.begin(), rank.end(), 0);
+    std::mt19937 rng(39);
+    std::ranges::shuffle(rank, rng);
+
+    std::uniform_int_distribution<size_t> pick(0, kNodeCount - 1);
+    for (int i = 0; i < 256; ++i) {
+        size_t from = pick(rng);
+        size_t to = pick(rng);
+        if (rank[from] >= rank[to]) {
+            continue;
+        }
+
+        auto& input = (i % 2 == 0) ? nodes[to]->inputs.input1 : nodes[to]->inputs.input2;
+        EXPECT_TRUE(scene.connect(nodes[from], nodes[from]->outputs.result, nodes[to], input));
+    }
+
+    const auto& order = scene.topologicalOrder();
+    ASSERT_EQ(order.size(), kNodeCount);
+
+    std::unordered_map<NodeHandle, size_t> position;
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = i;
+    }
+
+    for (const auto& conn : scene.getConnections()) {
+        EXPECT_LT(position.at(conn.nodeSource), position.at(conn.nodeTarget));
+    }
+}
+
+TEST_F(SceneTest, ExecutionPlanFollowsTopology)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+
+    const ExecutionPlan* plan = &scene.getExecutionPlan();
+    EXPECT_EQ(plan->steps.size(), 2);
+    EXPECT_TRUE(plan->links.empty());
+
+    scene.connect(nodeB, nodeB->outputs.result, nodeA, nodeA->inputs.input1);
+    plan = &scene.getExecutionPlan();
+
+    ASSERT_EQ(plan->steps.size(), 2);
+    EXPECT_EQ(plan->steps[0].handle, scene.getNodeHandle(nodeB));
+    EXPECT_EQ(plan->steps[0].successorCount, 1);
+    EXPECT_EQ(plan->steps[1].handle, scene.getNodeHandle(nodeA));
+    EXPECT_EQ(plan->steps[1].linkCount, 1);
+
+    ASSERT_EQ(plan->links.size(), 1);
+    EXPECT_EQ(plan->links[0].sourceHandle, nodeB->outputs.result.getHandle());
+    EXPECT_EQ(plan->links[0].targetHandle, nodeA->inputs.input1.getHandle());
+
+    // Replaying the plan propagates values through the links
+    scene.getAttribute(nodeB->inputs.input1.getHandle())->setValue(3.0f);
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeA->inputs.input1.getHandle())->getValue<float>(), 3.0f);
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeA->outputs.result.getHandle())->getValue<float>(), 3.0f);
+
+    scene.removeConnection(nodeB->outputs.result.getHandle(), nodeA->inputs.input1.getHandle());
+    EXPECT_TRUE(scene.getExecutionPlan().links.empty());
+}
+
+TEST_F(SceneTest, ConnectedInputsReadTheirSourceStorage)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    scene.connect(nodeB, nodeB->outputs.result, nodeA, nodeA->inputs.input1);
+
+    auto source = scene.getAttribute(nodeB->outputs.result.getHandle());
+    auto target = scene.getAttribute(nodeA->inputs.input1.getHandle());
+    EXPECT_EQ(target->getSource(), source.get());
+    EXPECT_EQ(target->getValueData(), source->getData());
+
+    scene.getAttribute(nodeB->inputs.input1.getHandle())->setValue(5.0f);
+    EXPECT_FLOAT_EQ(target->getValue<float>(), 5.0f);
+
+    // Disconnecting keeps the last value the input read
+    scene.removeConnection(nodeB->outputs.result.getHandle(), nodeA->inputs.input1.getHandle());
+    EXPECT_EQ(target->getSource(), nullptr);
+    EXPECT_EQ(target->getValueData(), target->getData());
+    EXPECT_FLOAT_EQ(target->getValue<float>(), 5.0f);
+}
+
+TEST_F(SceneTest, ParallelEvaluationMatchesSerial)
+{
+    constexpr size_t kBranchCount = 32;
+    constexpr size_t kBranchLength = 8;
+
+    ThreadPool pool(4);
+    Scene parallelScene;
+    parallelScene.setEvaluationMode(EvaluationMode::eParallel);
+    parallelScene.setThreadPool(pool);
+
+    // Wide graph: independent chains that all feed one sink per scene
+    auto build = [&](Scene& target) {
+        std::vector<std::shared_ptr<CountingAddNode>> nodes;
+        auto sink = target.addNode(std::make_unique<CountingAddNode>());
+        for (size_t branch = 0; branch < kBranchCount; ++branch) {
+            std::shared_ptr<CountingAddNode> previous;
+            for (size_t i = 0; i < kBranchLength; ++i) {
+                auto node = target.addNode(std::make_unique<CountingAddNode>());
+                target.getAttribute(node->inputs.input2.getHandle())->setValue(static_cast<float>(branch + i));
+                if (previous) {
+                    target.connect(previous, previous->outputs.result, node, node->inputs.input1);
+                }
+                nodes.push_back(node);
+                previous = node;
+            }
+            auto& sinkInput = (branch % 2 == 0) ? sink->inputs.input1 : sink->inputs.input2;
+            if (branch < 2) {
+                target.connect(previous, previous->outputs.result, sink, sinkInput);
+            }
+        }
+        nodes.push_back(sink);
+        return nodes;
+    };
+
+    auto serialNodes = build(scene);
+    auto parallelNodes = build(parallelScene);
+
+    scene.evaluate();
+    parallelScene.evaluate();
+
+    ASSERT_EQ(serialNodes.size(), parallelNodes.size());
+    for (size_t i = 0; i < serialNodes.size(); ++i) {
+        EXPECT_FLOAT_EQ(parallelScene.getAttribute(parallelNodes[i]->outputs.result.getHandle())->getValue<float>(),
+            scene.getAttribute(serialNodes[i]->outputs.result.getHandle())->getValue<float>());
+    }
+    EXPECT_EQ(parallelScene.getDirtyNodeCount(), 0);
+
+    // Incremental edits go through the same parallel path
+    parallelScene.getAttribute(parallelNodes.front()->inputs.input1.getHandle())->setValue(10.0f);
+    scene.getAttribute(serialNodes.front()->inputs.input1.getHandle())->setValue(10.0f);
+
+    for (size_t i = 0; i < serialNodes.size(); ++i) {
+        EXPECT_FLOAT_EQ(parallelScene.getAttribute(parallelNodes[i]->outputs.result.getHandle())->getValue<float>(),
+            scene.getAttribute(serialNodes[i]->outputs.result.getHandle())->getValue<float>());
+    }
+}
+
+TEST_F(SceneTest, TimeBudgetStopsBetweenComputes)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    auto nodeC = addCountingNode();
+    scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+    scene.connect(nodeB, nodeB->outputs.result, nodeC, nodeC->inputs.input1);
+    scene.evaluate();
+    for (auto& node : { nodeA, nodeB, nodeC }) {
+        node->computeCount = 0;
+    }
+
+    scene.setEvaluateOnChange(false);
+    scene.getAttribute(nodeA->inputs.input1.getHandle())->setValue(2.0f);
+
+    // An exhausted budget still lets each evaluation compute one node
+    CancellationToken token;
+    EXPECT_EQ(scene.evaluate(token, std::chrono::nanoseconds(0)), EvaluationStatus::eOutOfTime);
+    EXPECT_EQ(nodeA->computeCount, 1);
+    EXPECT_EQ(nodeB->computeCount, 0);
+    EXPECT_FALSE(scene.isDirty(scene.getNodeHandle(nodeA)));
+    EXPECT_TRUE(scene.isDirty(scene.getNodeHandle(nodeB)));
+    EXPECT_TRUE(scene.isDirty(scene.getNodeHandle(nodeC)));
+
+    EXPECT_EQ(scene.evaluate(token, std::chrono::nanoseconds(0)), EvaluationStatus::eOutOfTime);
+    EXPECT_EQ(scene.evaluate(token, std::chrono::nanoseconds(0)), EvaluationStatus::eComplete);
+    EXPECT_EQ(nodeA->computeCount, 1);
+    EXPECT_EQ(nodeB->computeCount, 1);
+    EXPECT_EQ(nodeC->computeCount, 1);
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeC->outputs.result.getHandle())->getValue<float>(), 2.0f);
+}
+
+TEST_F(SceneTest, CancelledEvaluationLeavesNodesDirty)
+{
+    ThreadPool pool(2);
+    scene.setThreadPool(pool);
+
+    for (EvaluationMode mode : { EvaluationMode::eSerial, EvaluationMode::eParallel }) {
+        scene.setEvaluationMode(mode);
+        auto nodeA = addCountingNode();
+        auto nodeB = addCountingNode();
+        scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+        const size_t dirtyCount = scene.getDirtyNodeCount();
+
+        CancellationToken token;
+        token.cancel();
+        EXPECT_EQ(scene.evaluate(token), EvaluationStatus::eCancelled);
+        EXPECT_EQ(nodeA->computeCount, 0);
+        EXPECT_EQ(nodeB->computeCount, 0);
+        EXPECT_EQ(scene.getDirtyNodeCount(), dirtyCount);
+
+        EXPECT_EQ(scene.evaluate(), EvaluationStatus::eComplete);
+        EXPECT_EQ(nodeB->computeCount, 1);
+        EXPECT_EQ(scene.getDirtyNodeCount(), 0);
+    }
+}
+
+TEST_F(SceneTest, FailedComputeLeavesItAndItsDownstreamDirty)
+{
+    ThreadPool pool(2);
+    scene.setThreadPool(pool);
+
+    for (EvaluationMode mode : { EvaluationMode::eSerial, EvaluationMode::eParallel }) {
+        scene.setEvaluationMode(mode);
+        auto nodeA = addCountingNode();
+        auto nodeB = addCountingNode();
+        auto nodeC = addCountingNode();
+        scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+        scene.connect(nodeB, nodeB->outputs.result, nodeC, nodeC->inputs.input1);
+
+        nodeB->shouldThrow = true;
+        EXPECT_THROW(scene.evaluate(), std::runtime_error);
+        EXPECT_EQ(nodeB->computeCount, 1);
+        EXPECT_EQ(nodeC->computeCount, 0);
+        EXPECT_FALSE(scene.isDirty(nodeA->getHandle()));
+        EXPECT_TRUE(scene.isDirty(nodeB->getHandle()));
+        EXPECT_TRUE(scene.isDirty(nodeC->getHandle()));
+
+        nodeB->shouldThrow = false;
+        EXPECT_EQ(scene.evaluate(), EvaluationStatus::eComplete);
+        EXPECT_EQ(nodeA->computeCount, 1);
+        EXPECT_EQ(nodeB->computeCount, 2);
+        EXPECT_EQ(nodeC->computeCount, 1);
+        EXPECT_EQ(scene.getDirtyNodeCount(), 0);
+    }
+}
+
+TEST_F(SceneTest, ResultCacheSkipsComputeForRecentInputs)
+{
+    ASSERT_TRUE(scene.enableResultCache<CountingAddNode>(2));
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+    scene.evaluate();
+
+    auto input = scene.getAttribute(nodeA->inputs.input1.getHandle());
+    auto result = scene.getAttribute(nodeB->outputs.result.getHandle());
+    input->setValue(1.0f);
+    input->setValue(2.0f);
+    const int computeCount = nodeA->computeCount;
+
+    // Both input values are still cached
+    input->setValue(1.0f);
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 1.0f);
+    input->setValue(2.0f);
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 2.0f);
+    EXPECT_EQ(nodeA->computeCount, computeCount);
+    EXPECT_EQ(nodeB->computeCount, computeCount);
+
+    // A third value evicts the least recently used one
+    input->setValue(3.0f);
+    input->setValue(1.0f);
+    EXPECT_EQ(nodeA->computeCount, computeCount + 2);
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 1.0f);
+
+    const ResultCacheStats stats = scene.getResultCacheStats();
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 2u * computeCount + 4u);
+    EXPECT_EQ(scene.findResultCache(scene.getNodeHandle(nodeA))->getStats().hits, 2u);
+}
+
+TEST_F(SceneTest, ResultCacheDoesNotRestoreOnHashCollision)
+{
+    TypeRegistry::registerType<UInt64>();
+    AttributeDescriptor desc;
+    desc.name = "UInt64 Attribute";
+    desc.typeHandle = TypeRegistry::getTypeHandle<UInt64>();
+    TypeRegistry::registerAttributeDescriptor(desc);
+
+    Attribute input1(desc, makeSlotHandle(0, 1));
+    Attribute input2(desc, makeSlotHandle(1, 1));
+    Attribute output(desc, makeSlotHandle(2, 1));
+    ResultCache cache({ &input1, &input2 }, { &output }, 4);
+
+    input1.setValue(UInt64 { 1 });
+    input2.setValue(UInt64 { 2 });
+    output.setValue(UInt64 { 10 });
+    const uint64_t inputHash = cache.hashInputs();
+    cache.store(inputHash);
+
+    // std::hash of an integer is the integer itself, so a second input can
+    // be solved for that cancels out a different first input
+    auto combine = [](uint64_t seed, uint64_t value) { return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)); };
+    const uint64_t seed = combine(2, 5);
+    const uint64_t colliding = (inputHash ^ seed) - 0x9e3779b97f4a7c15ULL - (seed << 6) - (seed >> 2);
+    input1.setValue(UInt64 { 5 });
+    input2.setValue(UInt64 { colliding });
+    output.setValue(UInt64 { 0 });
+    ASSERT_EQ(cache.hashInputs(), inputHash);
+
+    EXPECT_FALSE(cache.restore(inputHash));
+    EXPECT_EQ(output.getValue<UInt64>(), 0u);
+
+    input1.setValue(UInt64 { 1 });
+    input2.setValue(UInt64 { 2 });
+    EXPECT_TRUE(cache.restore(inputHash));
+    EXPECT_EQ(output.getValue<UInt64>(), 10u);
+}
+
+TEST_F(SceneTest, ResultCacheIsOptInPerNodeType)
+{
+    auto counting = addCountingNode();
+    auto add = scene.addNode(std::make_unique<AddNode>());
+
+    EXPECT_TRUE(scene.enableResultCache<CountingAddNode>(4));
+    EXPECT_NE(scene.findResultCache(scene.getNodeHandle(counting)), nullptr);
+    EXPECT_EQ(scene.findResultCache(scene.getNodeHandle(add)), nullptr);
+
+    EXPECT_TRUE(scene.enableResultCache<CountingAddNode>(0));
+    EXPECT_EQ(scene.findResultCache(scene.getNodeHandle(counting)), nullptr);
+    EXPECT_EQ(scene.findResultCache(scene.getNodeHandle(addCountingNode())), nullptr);
+}
+
+TEST_F(SceneTest, DemandDrivenEvaluationSkipsUnobservedBranches)
+{
+    ThreadPool pool(2);
+    scene.setThreadPool(pool);
+
+    for (EvaluationMode mode : { EvaluationMode::eSerial, EvaluationMode::eParallel }) {
+        scene.setEvaluationMode(mode);
+        scene.setDemandDriven(true);
+
+        // source feeds an observed branch and an unused one
+        auto source = addCountingNode();
+        auto observed = addCountingNode();
+        auto unused = addCountingNode();
+        scene.connect(source, source->outputs.result, observed, observed->inputs.input1);
+        scene.connect(source, source->outputs.result, unused, unused->inputs.input1);
+
+        // Requesting an output evaluates what it depends on
+        const AttributeHandle result = observed->outputs.result.getHandle();
+        scene.requestOutput(result);
+        EXPECT_EQ(observed->computeCount, 1);
+
+        scene.getAttribute(source->inputs.input1.getHandle())->setValue(2.0f);
+        EXPECT_EQ(source->computeCount, 2);
+        EXPECT_EQ(observed->computeCount, 2);
+        EXPECT_EQ(unused->computeCount, 0);
+        EXPECT_TRUE(scene.isDirty(scene.getNodeHandle(unused)));
+        EXPECT_FLOAT_EQ(scene.getAttribute(result)->getValue<float>(), 2.0f);
+
+        // Requesting the unused branch brings it up to date
+        scene.requestOutput(unused->outputs.result.getHandle());
+        EXPECT_EQ(unused->computeCount, 1);
+        EXPECT_EQ(source->computeCount, 2);
+        EXPECT_FLOAT_EQ(scene.getAttribute(unused->outputs.result.getHandle())->getValue<float>(), 2.0f);
+
+        scene.releaseOutput(unused->outputs.result.getHandle());
+        scene.releaseOutput(result);
+        EXPECT_FALSE(scene.isOutputRequested(result));
+        scene.setDemandDriven(false);
+        scene.evaluate();
+    }
+}
+
+TEST_F(SceneTest, EvaluateOutputsComputesOnlyTheirUpstream)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    auto nodeC = addCountingNode();
+    scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+    scene.connect(nodeB, nodeB->outputs.result, nodeC, nodeC->inputs.input1);
+    scene.setEvaluateOnChange(false);
+    scene.getAttribute(nodeA->inputs.input1.getHandle())->setValue(1.0f);
+
+    EXPECT_EQ(scene.evaluateOutputs({ nodeB->outputs.result.getHandle() }), EvaluationStatus::eComplete);
+    EXPECT_EQ(nodeA->computeCount, 1);
+    EXPECT_EQ(nodeB->computeCount, 1);
+    EXPECT_EQ(nodeC->computeCount, 0);
+    EXPECT_EQ(scene.getDirtyNodeCount(), 1u);
+
+    scene.evaluate();
+    EXPECT_EQ(nodeC->computeCount, 1);
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeC->outputs.result.getHandle())->getValue<float>(), 1.0f);
+}
+
+TEST_F(SceneTest, TransactionEvaluatesOnceAtCommit)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    scene.connect(nodeA, nodeA->outputs.result, nodeB, nodeB->inputs.input1);
+    scene.evaluate();
+    nodeA->computeCount = 0;
+    nodeB->computeCount = 0;
+
+    auto input = scene.getAttribute(nodeA->inputs.input1.getHandle());
+    {
+        SceneTransaction transaction(scene);
+        for (int i = 1; i <= 100; ++i) {
+            input->setValue(static_cast<float>(i));
+        }
+        scene.getAttribute(nodeA->inputs.input2.getHandle())->setValue(0.5f);
+
+        scene.evaluate();
+        EXPECT_EQ(nodeA->computeCount, 0);
+    }
+
+    EXPECT_EQ(nodeA->computeCount, 1);
+    EXPECT_EQ(nodeB->computeCount, 1);
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeB->outputs.result.getHandle())->getValue<float>(), 100.5f);
+}
+
+TEST_F(SceneTest, TransactionPublishesEachChangeOnce)
+{
+    auto node = addCountingNode();
+    scene.evaluate();
+
+    const AttributeHandle input = node->inputs.input1.getHandle();
+    int notifications = 0;
+    auto subscription = EventBus::subscribe<AttributeEvent>([&](const AttributeEvent& event) {
+        if (event.attributeHandle == input) {
+            ++notifications;
+        }
+    });
+
+    scene.beginTransaction();
+    for (int i = 0; i < 10; ++i) {
+        scene.getAttribute(input)->setValue(static_cast<float>(i));
+    }
+    EXPECT_EQ(notifications, 0);
+    scene.commitTransaction();
+
+    EventBus::unsubscribe(subscription);
+    EXPECT_EQ(notifications, 1);
+}
+
+TEST_F(SceneTest, NestedTransactionsCommitWithTheOutermost)
+{
+    auto node = addCountingNode();
+    scene.evaluate();
+    node->computeCount = 0;
+
+    scene.beginTransaction();
+    scene.beginTransaction();
+    scene.getAttribute(node->inputs.input1.getHandle())->setValue(3.0f);
+    EXPECT_TRUE(scene.commitTransaction().empty());
+    EXPECT_TRUE(scene.isInTransaction());
+    EXPECT_EQ(node->computeCount, 0);
+
+    auto edits = scene.commitTransaction();
+    EXPECT_FALSE(scene.isInTransaction());
+    EXPECT_EQ(node->computeCount, 1);
+    ASSERT_EQ(edits.size(), 1u);
+    EXPECT_EQ(edits.front().handle, node->inputs.input1.getHandle());
+    EXPECT_FLOAT_EQ(*static_cast<const float*>(edits.front().previousValue.get()), 0.0f);
+}
+
+TEST_F(SceneTest, OverlappingTransactionsOnTwoScenesCommitInAnyOrder)
+{
+    auto node = addCountingNode();
+    Scene other;
+    auto otherNode = other.addNode(std::make_unique<CountingAddNode>());
+    auto input = scene.getAttribute(node->inputs.input1.getHandle());
+    auto otherInput = other.getAttribute(otherNode->inputs.input1.getHandle());
+    scene.evaluate();
+    other.evaluate();
+
+    scene.beginTransaction();
+    other.beginTransaction();
+    input->setValue(1.0f);
+    otherInput->setValue(2.0f);
+
+    // Committed before the transaction opened after it
+    auto edits = scene.commitTransaction();
+    ASSERT_EQ(edits.size(), 1u);
+    EXPECT_EQ(edits.front().attribute, input.get());
+    EXPECT_FLOAT_EQ(scene.getAttribute(node->outputs.result.getHandle())->getValue<float>(), 1.0f);
+
+    otherInput->setValue(3.0f);
+    auto otherEdits = other.commitTransaction();
+    ASSERT_EQ(otherEdits.size(), 1u);
+    EXPECT_EQ(otherEdits.front().attribute, otherInput.get());
+    EXPECT_FLOAT_EQ(*static_cast<const float*>(otherEdits.front().previousValue.get()), 0.0f);
+    EXPECT_FLOAT_EQ(other.getAttribute(otherNode->outputs.result.getHandle())->getValue<float>(), 3.0f);
+
+    // Both scopes are closed, so plain edits evaluate right away again
+    input->setValue(4.0f);
+    EXPECT_FLOAT_EQ(scene.getAttribute(node->outputs.result.getHandle())->getValue<float>(), 4.0f);
+}
+
+TEST_F(SceneTest, TransactionIsASingleUndoEntry)
+{
+    Document document;
+    document.createNewScene();
+    auto sharedScene = document.getScene();
+
+    auto node = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    auto input1 = sharedScene->getAttribute(node->inputs.input1.getHandle());
+    auto input2 = sharedScene->getAttribute(node->inputs.input2.getHandle());
+    auto result = sharedScene->getAttribute(node->outputs.result.getHandle());
+    input1->setValue(1.0f);
+    input2->setValue(2.0f);
+
+    {
+        auto transaction = document.beginTransaction();
+        input1->setValue(10.0f);
+        input1->setValue(20.0f);
+        input2->setValue(30.0f);
+    }
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 50.0f);
+    node->computeCount = 0;
+
+    document.getUndoStack().undo();
+    EXPECT_FALSE(document.getUndoStack().canUndo());
+    EXPECT_FLOAT_EQ(input1->getValue<float>(), 1.0f);
+    EXPECT_FLOAT_EQ(input2->getValue<float>(), 2.0f);
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 3.0f);
+    EXPECT_EQ(node->computeCount, 1);
+
+    document.getUndoStack().redo();
+    EXPECT_FLOAT_EQ(input1->getValue<float>(), 20.0f);
+    EXPECT_FLOAT_EQ(result->getValue<float>(), 50.0f);
+    EXPECT_EQ(node->computeCount, 2);
+}
+
+TEST_F(SceneTest, RemovingANodeDropsItsAttributesAndConnections)
+{
+    auto nodeA = addCountingNode();
+    auto nodeB = addCountingNode();
+    auto nodeC = addCountingNode();
+    scene.addConnection(nodeA->outputs.result.getHandle(), nodeB->inputs.input1.getHandle());
+    scene.addConnection(nodeB->outputs.result.getHandle(), nodeC->inputs.input1.getHandle());
+    scene.getAttribute(nodeA->inputs.input1.getHandle())->setValue(2.0f);
+    scene.evaluate();
+
+    const NodeHandle handleB = nodeB->getHandle();
+    const AttributeHandle outputB = nodeB->outputs.result.getHandle();
+    RemovedNodes removed = scene.removeNode(handleB);
+
+    ASSERT_EQ(removed.nodes.size(), 1u);
+    EXPECT_EQ(removed.connections.size(), 2u);
+    EXPECT_EQ(scene.getNode(handleB), nullptr);
+    EXPECT_EQ(scene.getAttribute(outputB), nullptr);
+    EXPECT_EQ(nodeB->getHandle(), kInvalidNodeHandle);
+    EXPECT_EQ(scene.getNodes().size(), 2u);
+    EXPECT_EQ(scene.getAttributes().size(), 6u);
+    EXPECT_TRUE(scene.getConnections().empty());
+    EXPECT_TRUE(scene.getNodeConnections(nodeA->getHandle()).outgoing.empty());
+    EXPECT_EQ(scene.topologicalOrder(), (std::vector<NodeHandle> { nodeA->getHandle(), nodeC->getHandle() }));
+
+    // The disconnected input keeps the value it last read, and the removed
+    // node keeps its own for as long as it is held
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeC->inputs.input1.getHandle())->getValue<float>(), 2.0f);
+    EXPECT_FLOAT_EQ(removed.nodes[0].attributes[2]->getValue<float>(), 2.0f);
+    EXPECT_TRUE(scene.isDirty(nodeC->getHandle()));
+
+    scene.evaluate();
+    EXPECT_FLOAT_EQ(scene.getAttribute(nodeC->outputs.result.getHandle())->getValue<float>(), 2.0f);
+
+    // Slots are only reused, under new handles, once the removal is dropped
+    auto nodeD = addCountingNode();
+    EXPECT_NE(getSlotIndex(nodeD->getHandle()), getSlotIndex(handleB));
+    removed = {};
+    auto nodeE = addCountingNode();
+    EXPECT_EQ(getSlotIndex(nodeE->getHandle()), getSlotIndex(handleB));
+    EXPECT_NE(nodeE->getHandle(), handleB);
+    EXPECT_EQ(scene.getNode(handleB), nullptr);
+}
+
+TEST_F(SceneTest, NodesAddedAfterARemovalDoNotBlockItsUndo)
+{
+    Document document;
+    document.createNewScene();
+    auto sharedScene = document.getScene();
+    UndoStack& undoStack = document.getUndoStack();
+
+    auto node = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    auto input = sharedScene->getAttribute(node->inputs.input1.getHandle());
+    {
+        auto transaction = document.beginTransaction();
+        input->setValue(5.0f);
+    }
+
+    const NodeHandle handle = node->getHandle();
+    undoStack.push(std::make_unique<RemoveNodesCommand>(sharedScene, std::vector<NodeHandle> { handle }));
+    const std::vector<NodeHandle> added = sharedScene->addNodes<CountingAddNode>(1);
+    EXPECT_NE(getSlotIndex(added[0]), getSlotIndex(handle));
+
+    undoStack.undo();
+    EXPECT_EQ(sharedScene->getNode(handle), node);
+    EXPECT_FLOAT_EQ(input->getValue<float>(), 5.0f);
+
+    undoStack.undo();
+    EXPECT_FALSE(undoStack.canUndo());
+    EXPECT_FLOAT_EQ(input->getValue<float>(), 0.0f);
+    EXPECT_EQ(sharedScene->getNodes().size(), 2u);
+}
+
+TEST_F(SceneTest, RemoveNodesPublishesOneEventAndCanBeUndone)
+{
+    auto sharedScene = std::make_shared<Scene>();
+    auto nodeA = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    auto nodeB = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    auto nodeC = sharedScene->addNode(std::make_unique<CountingAddNode>());
+    sharedScene->addConnection(nodeA->outputs.result.getHandle(), nodeB->inputs.input1.getHandle());
+    sharedScene->addConnection(nodeB->outputs.result.getHandle(), nodeC->inputs.input2.getHandle());
+    sharedScene->getAttribute(nodeA->inputs.input2.getHandle())->setValue(3.0f);
+    sharedScene->getAttribute(nodeB->inputs.input2.getHandle())->setValue(4.0f);
+    sharedScene->requestOutput(nodeB->outputs.result.getHandle());
+
+    std::vector<NodeEvent> events;
+    auto subscription = EventBus::subscribe<NodeEvent>([&](const NodeEvent& event) {
+        events.push_back(event);
+    });
+
+    const NodeHandle handleA = nodeA->getHandle();
+    const NodeHandle handleB = nodeB->getHandle();
+    UndoStack undoStack;
+    undoStack.push(std::make_unique<RemoveNodesCommand>(sharedScene, std::vector<NodeHandle> { handleA, handleB, handleA }));
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].m_message, NodeEvent::NodeMessage::eNodesRemoved);
+    EXPECT_EQ(events[0].nodes, (std::vector<NodeHandle> { handleA, handleB }));
+    EXPECT_EQ(events[0].connections.size(), 2u);
+    EXPECT_EQ(sharedScene->getNodes().size(), 1u);
+    EXPECT_FALSE(sharedScene->isOutputRequested(nodeB->outputs.result.getHandle()));
+
+    undoStack.undo();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[1].m_message, NodeEvent::NodeMessage::eNodesRestored);
+    EXPECT_EQ(sharedScene->getNode(handleA), nodeA);
+    EXPECT_EQ(sharedScene->getNode(handleB), nodeB);
+    EXPECT_EQ(sharedScene->getAttributeNode(nodeB->inputs.input2.getHandle()), handleB);
+    EXPECT_EQ(sharedScene->getConnections().size(), 2u);
+    EXPECT_TRUE(sharedScene->isOutputRequested(nodeB->outputs.result.getHandle()));
+    EXPECT_FLOAT_EQ(sharedScene->getAttribute(nodeB->inputs.input2.getHandle())->getValue<float>(), 4.0f);
+
+    // Restored nodes rejoin the order after their upstream nodes
+    const auto& order = sharedScene->topologicalOrder();
+    auto position = [&](NodeHandle handle) { return std::ranges::find(order, handle) - order.begin(); };
+    EXPECT_LT(position(handleA), position(handleB));
+    EXPECT_LT(position(handleB), position(nodeC->getHandle()));
+
+    sharedScene->evaluate();
+    EXPECT_FLOAT_EQ(sharedScene->getAttribute(nodeC->outputs.result.getHandle())->getValue<float>(), 7.0f);
+
+    undoStack.redo();
+    EXPECT_EQ(sharedScene->getNode(handleA), nullptr);
+    EXPECT_TRUE(sharedScene->getConnections().empty());
+
+    EventBus::unsubscribe(subscription);
+}
+
+} // namespace cf::core::test
@@ -0,0 +1,67 @@
+#include "Core/SlotMap.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace cf::core::test {
+
+TEST(SlotMapTest, ErasedHandlesGoStaleWhenTheSlotIsReused)
+{
+    SlotMap<std::string> map;
+    const SlotHandle first = map.insert("first");
+    const SlotHandle second = map.insert("second");
+    EXPECT_NE(first, 0u);
+    EXPECT_EQ(*map.find(second), "second");
+
+    EXPECT_TRUE(map.erase(first));
+    EXPECT_FALSE(map.erase(first));
+    EXPECT_EQ(map.find(first), nullptr);
+
+    // The freed slot is reused under a new generation
+    const SlotHandle third = map.insert("third");
+    EXPECT_EQ(getSlotIndex(third), getSlotIndex(first));
+    EXPECT_NE(third, first);
+    EXPECT_FALSE(map.contains(first));
+    EXPECT_EQ(*map.find(third), "third");
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.getSlotCount(), 2u);
+}
+
+TEST(SlotMapTest, IterationSkipsFreeSlots)
+{
+    SlotMap<int> map;
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 5; ++i) {
+        handles.push_back(map.insert(i));
+    }
+    map.erase(handles[1]);
+    map.erase(handles[3]);
+
+    std::vector<int> values;
+    for (const auto& [handle, value] : map) {
+        EXPECT_EQ(handle, handles[value]);
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, (std::vector<int> { 0, 2, 4 }));
+}
+
+TEST(SlotMapTest, RetainedSlotsAreNotReusedUntilReleased)
+{
+    SlotMap<std::string> map;
+    const SlotHandle first = map.insert("first");
+    map.retainSlot(first);
+    map.erase(first);
+
+    const SlotHandle second = map.insert("second");
+    EXPECT_NE(getSlotIndex(second), getSlotIndex(first));
+    EXPECT_TRUE(map.restore(first, "first"));
+    EXPECT_EQ(*map.find(first), "first");
+
+    // Released while live, the slot is only freed by the next erase
+    map.releaseSlot(first);
+    map.erase(first);
+    EXPECT_EQ(getSlotIndex(map.insert("third")), getSlotIndex(first));
+}
+
+} // namespace cf::core::test
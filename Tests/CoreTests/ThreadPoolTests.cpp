@@ -0,0 +1,84 @@
+#include "Core/ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace cf;
+using namespace cf::core;
+
+namespace {
+
+void waitFor(ThreadPool& pool, const std::atomic<int>& counter, int expected)
+{
+    while (counter.load() < expected) {
+        if (!pool.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace
+
+TEST(ThreadPoolTest, RunsSubmittedTasks)
+{
+    ThreadPool pool(4);
+    std::atomic<int> counter { 0 };
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&counter] { counter.fetch_add(1); });
+    }
+
+    waitFor(pool, counter, 1000);
+    EXPECT_EQ(counter.load(), 1000);
+    EXPECT_EQ(pool.getThreadCount(), 4);
+}
+
+TEST(ThreadPoolTest, TasksCanSubmitTasks)
+{
+    ThreadPool pool(4);
+    std::atomic<int> counter { 0 };
+
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&pool, &counter] {
+            for (int j = 0; j < 10; ++j) {
+                pool.submit([&counter] { counter.fetch_add(1); });
+            }
+            counter.fetch_add(1);
+        });
+    }
+
+    waitFor(pool, counter, 110);
+    EXPECT_EQ(counter.load(), 110);
+}
+
+TEST(ThreadPoolTest, WaitingInsideTaskDoesNotDeadlock)
+{
+    ThreadPool pool(1);
+    std::atomic<int> inner { 0 };
+    std::atomic<int> outer { 0 };
+
+    // The only worker waits on work queued behind it and must run it itself
+    pool.submit([&] {
+        pool.submit([&inner] { inner.fetch_add(1); });
+        waitFor(pool, inner, 1);
+        outer.fetch_add(1);
+    });
+
+    waitFor(pool, outer, 1);
+    EXPECT_EQ(inner.load(), 1);
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueuedTasks)
+{
+    std::atomic<int> counter { 0 };
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&counter] { counter.fetch_add(1); });
+        }
+    }
+
+    EXPECT_EQ(counter.load(), 100);
+}
@@ -0,0 +1,123 @@
+#include "Core/DataTypes.hpp"
+#include "Core/Nodes/ComposeTransformNode.hpp"
+#include "Core/Nodes/MultiplyMatrixNode.hpp"
+#include "Core/Nodes/RotateVectorNode.hpp"
+#include "Core/Nodes/TransformPointNode.hpp"
+#include "Core/SampleBatch.hpp"
+#include "Core/Scene.hpp"
+#include "Core/TypeRegistry.hpp"
+#include "gtest/gtest.h"
+
+#include <numbers>
+
+namespace cf::core::test {
+
+class TransformNodeTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        TypeRegistry::registerType<Vec2>();
+        TypeRegistry::registerType<Vec3>();
+        TypeRegistry::registerType<Vec4>();
+        TypeRegistry::registerType<Quat>();
+        TypeRegistry::registerType<Mat3>();
+        TypeRegistry::registerType<Mat4>();
+
+        TypeRegistry::registerNodeType<ComposeTransformNode>();
+        TypeRegistry::registerNodeType<MultiplyMatrixNode>();
+        TypeRegistry::registerNodeType<RotateVectorNode>();
+        TypeRegistry::registerNodeType<TransformPointNode>();
+    }
+
+    template <typename Type>
+    Type value(AttributeHandle handle) const { return scene.getAttribute(handle)->getValue<Type>(); }
+
+    static Quat quarterTurnAroundZ() { return Quat(Eigen::AngleAxisf(std::numbers::pi_v<float> / 2.0f, Vec3::UnitZ())); }
+
+    Scene scene;
+};
+
+TEST_F(TransformNodeTest, MathTypesStartAlignedAtZeroOrIdentity)
+{
+    const TypeDescriptor& desc = TypeRegistry::getTypeDescriptor<Mat4>();
+    EXPECT_EQ(desc.alignment, alignof(Mat4));
+
+    void* matrix = desc.create();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(matrix) % alignof(Mat4), 0u);
+    EXPECT_TRUE(static_cast<Mat4*>(matrix)->isIdentity());
+    desc.destroy(matrix);
+
+    void* vectors = TypeRegistry::getTypeDescriptor<Vec4>().createArray(5);
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(static_cast<Vec4*>(vectors)[i].isZero());
+    }
+    TypeRegistry::getTypeDescriptor<Vec4>().destroyArray(vectors);
+
+    EXPECT_EQ(TypeRegistry::getTypeDescriptor<Vec3>().toString(Vec3(1.0f, 2.0f, 3.0f).data()), "(1.000000, 2.000000, 3.000000)");
+}
+
+TEST_F(TransformNodeTest, ComposedTransformMovesPoints)
+{
+    auto compose = scene.addNode(std::make_unique<ComposeTransformNode>());
+    auto transform = scene.addNode(std::make_unique<TransformPointNode>());
+    scene.addConnection(compose->outputs.transform.getHandle(), transform->inputs.transform.getHandle());
+
+    scene.getAttribute(compose->inputs.translation.getHandle())->setValue(Vec3(1.0f, 0.0f, 0.0f));
+    scene.getAttribute(compose->inputs.rotation.getHandle())->setValue(quarterTurnAroundZ());
+    scene.getAttribute(compose->inputs.scale.getHandle())->setValue(Vec3(2.0f, 2.0f, 2.0f));
+    scene.getAttribute(transform->inputs.point.getHandle())->setValue(Vec3(1.0f, 0.0f, 0.0f));
+    scene.evaluate();
+
+    // Scaled to (2, 0, 0), turned to (0, 2, 0), then moved
+    EXPECT_TRUE(value<Vec3>(transform->outputs.result.getHandle()).isApprox(Vec3(1.0f, 2.0f, 0.0f)));
+}
+
+TEST_F(TransformNodeTest, MultiplyAppliesTheRightTransformFirst)
+{
+    auto multiply = scene.addNode(std::make_unique<MultiplyMatrixNode>());
+
+    Mat4 translate = Mat4::Identity();
+    translate.topRightCorner<3, 1>() = Vec3(0.0f, 0.0f, 5.0f);
+    Mat4 scale = Mat4::Identity();
+    scale.topLeftCorner<3, 3>() *= 3.0f;
+
+    scene.getAttribute(multiply->inputs.lhs.getHandle())->setValue(translate);
+    scene.getAttribute(multiply->inputs.rhs.getHandle())->setValue(scale);
+    scene.evaluate();
+
+    const Vec4 point = value<Mat4>(multiply->outputs.result.getHandle()) * Vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    EXPECT_TRUE(point.isApprox(Vec4(3.0f, 3.0f, 8.0f, 1.0f)));
+}
+
+TEST_F(TransformNodeTest, RotateVectorUsesUnitQuaternion)
+{
+    auto rotate = scene.addNode(std::make_unique<RotateVectorNode>());
+    scene.getAttribute(rotate->inputs.rotation.getHandle())->setValue(Quat(quarterTurnAroundZ().coeffs() * 4.0f));
+    scene.getAttribute(rotate->inputs.vector.getHandle())->setValue(Vec3(0.0f, 1.0f, 0.0f));
+    scene.evaluate();
+
+    EXPECT_TRUE(value<Vec3>(rotate->outputs.result.getHandle()).isApprox(Vec3(-1.0f, 0.0f, 0.0f)));
+}
+
+TEST_F(TransformNodeTest, BatchTransformsEveryPoint)
+{
+    auto transform = scene.addNode(std::make_unique<TransformPointNode>());
+    Mat4 translate = Mat4::Identity();
+    translate.topRightCorner<3, 1>() = Vec3(1.0f, 2.0f, 3.0f);
+    scene.getAttribute(transform->inputs.transform.getHandle())->setValue(translate);
+
+    constexpr size_t kSampleCount = 16;
+    SampleBatch batch(scene, kSampleCount);
+    auto points = batch.getLanes<Vec3>(transform->inputs.point.getHandle());
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        points[i] = Vec3::Constant(static_cast<float>(i));
+    }
+
+    batch.evaluate();
+    auto results = batch.getOutput(transform->outputs.result);
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        EXPECT_TRUE(results[i].isApprox(points[i] + Vec3(1.0f, 2.0f, 3.0f))) << "sample " << i;
+    }
+}
+
+} // namespace cf::core::test
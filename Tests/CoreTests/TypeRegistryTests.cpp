@@ -115,6 +115,25 @@ TEST_F(TypeRegistryTest, ExtractNameFromType)
     EXPECT_EQ(desc.name, "cf::core::test::MyCustomType");
 }
 
+TEST_F(TypeRegistryTest, DescriptorsAreSharedFunctionTables)
+{
+    TypeRegistry::registerType<Int32>();
+    TypeRegistry::registerType<MyCustomType>();
+
+    // Looked up by reference, so every caller sees the same table
+    const TypeDescriptor& desc = TypeRegistry::getTypeDescriptor<Int32>();
+    EXPECT_EQ(&desc, &TypeRegistry::getTypeDescriptor(TypeRegistry::getTypeHandle<Int32>()));
+
+    void* value = desc.create();
+    const Int32 source = 7;
+    desc.copy(value, &source);
+    EXPECT_EQ(desc.toString(value), "7");
+    EXPECT_NE(desc.hash, nullptr);
+    desc.destroy(value);
+
+    EXPECT_EQ(TypeRegistry::getTypeDescriptor<MyCustomType>().hash, nullptr);
+}
+
 // Node Registration Tests
 TEST_F(TypeRegistryTest, RegisterAndRetrieveNodeType)
 {